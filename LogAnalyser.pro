@@ -4,10 +4,19 @@
 #
 #-------------------------------------------------
 
-QT       += core gui sql xml printsupport
+QT       += core gui sql xml printsupport concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
+CONFIG   += c++17
+
+# compressed MeasDocs: gzip is always supported, zstd if the library is installed
+LIBS     += -lz
+packagesExist(libzstd) {
+    DEFINES  += C_WITH_ZSTD
+    LIBS     += -lzstd
+}
+
 TARGET = LogAnalyser
 TEMPLATE = app
 
@@ -16,11 +25,52 @@ SOURCES += main.cpp         \
            mainwindow.cpp   \
            qcustomplot.cpp  \
            dbinterface.cpp  \
-           xmlparses.cpp
+           xmlparses.cpp    \
+           timestampdecoder.cpp \
+           telemetrystore.cpp \
+           logdecoder.cpp \
+           tsqualitycheck.cpp \
+           derivedchannels.cpp \
+           energyanalytics.cpp \
+           stateintervals.cpp \
+           gapdetector.cpp \
+           anomalydetector.cpp \
+           quantilesketch.cpp \
+           fleetsummary.cpp \
+           fleetview.cpp \
+           recordmerger.cpp \
+           measdocloader.cpp \
+           decompressingdevice.cpp \
+           sqldumpreader.cpp \
+           ingestpipeline.cpp \
+           phasetimer.cpp \
+           phaseview.cpp
 
 HEADERS  += mainwindow.h    \
             qcustomplot.h   \
             dbinterface.h   \
-            xmlparses.h
+            xmlparses.h     \
+            timestampdecoder.h \
+            numberparser.h  \
+            statusdecoder.h \
+            telemetrystore.h \
+            logdecoder.h \
+            tskernels.h \
+            tsqualitycheck.h \
+            derivedchannels.h \
+            energyanalytics.h \
+            stateintervals.h \
+            gapdetector.h \
+            anomalydetector.h \
+            quantilesketch.h \
+            fleetsummary.h \
+            fleetview.h \
+            recordmerger.h \
+            measdocloader.h \
+            decompressingdevice.h \
+            sqldumpreader.h \
+            ingestpipeline.h \
+            phasetimer.h \
+            phaseview.h
 
 FORMS    += mainwindow.ui
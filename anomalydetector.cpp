@@ -0,0 +1,245 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file anomalydetector.cpp
+ *
+ * \brief contains the implementation of the AnomalyDetector class.
+ *
+ * ---
+ */
+
+
+#include "anomalydetector.h"
+
+#include <cmath>
+#include <limits>
+
+
+/**
+ * \brief returns a rule with the given parameters.
+ */
+static sAnomalyRule_t anomalyRule (const QString& qstrChannel, const double dZThreshold, const double dMinStdDev,
+                                   const double dMaxRate, const double dMinDelta, const int iRateSign,
+                                   const double dMinValue, const double dMaxValue)
+{
+    sAnomalyRule_t sRule;
+
+    sRule.qstrChannel = qstrChannel;
+    sRule.dAlpha      = 0.05;
+    sRule.dZThreshold = dZThreshold;
+    sRule.dMinStdDev  = dMinStdDev;
+    sRule.dMaxRate    = dMaxRate;
+    sRule.dMinDelta   = dMinDelta;
+    sRule.iRateSign   = iRateSign;
+    sRule.dMinValue   = dMinValue;
+    sRule.dMaxValue   = dMaxValue;
+
+    return (sRule);
+}
+
+
+AnomalyDetector::AnomalyDetector (void)
+{
+    const double dNaN = std::numeric_limits<double>::quiet_NaN ();
+
+    this->lliMaxGapSeconds     = 900;
+    this->lliRateWindowSeconds = 1800;
+
+    // the min. changes are several steps of the decoded resolution (0.1 V, 1 degree C), the battery
+    // is only checked for drops, the temperatures only for heating
+    //                          channel        z    min. std  rate/h  min. change  sign  min     max
+    this->addRule (anomalyRule ("batt_volt",   5.0, 0.1,      2.0,    0.3,         -1,   10.5,   dNaN));
+    this->addRule (anomalyRule ("temp",        5.0, 0.5,      20.0,   3.0,         +1,   dNaN,   70.0));
+    this->addRule (anomalyRule ("temp_sensor", 5.0, 0.5,      20.0,   3.0,         +1,   dNaN,   60.0));
+    this->addRule (anomalyRule ("batt1_curr",  6.0, 0.05,     0.0,    0.0,          0,   dNaN,   dNaN));
+    this->addRule (anomalyRule ("batt2_curr",  6.0, 0.05,     0.0,    0.0,          0,   dNaN,   dNaN));
+}
+
+
+void AnomalyDetector::addRule (const sAnomalyRule_t& sRule)
+{
+    this->qvecRules.push_back (sRule);
+    this->reset ();
+}
+
+
+void AnomalyDetector::reset (void)
+{
+    // declaration of variables
+    sRuleState_t sState;
+
+    sState.iCount         = 0;
+    sState.dMean          = 0.0;
+    sState.dVariance      = 0.0;
+    sState.dLastValue     = 0.0;
+    sState.tLastTimeStamp = 0;
+    sState.dRateValue     = 0.0;
+    sState.tRateTimeStamp = 0;
+    sState.abActive [ANOMALY_ZSCORE] = false;
+    sState.abActive [ANOMALY_RATE]   = false;
+    sState.abActive [ANOMALY_LIMIT]  = false;
+
+    this->qvecStates.fill (sState, this->qvecRules.size ());
+    this->qvecEvents.clear ();
+    this->uiContentId = 0;
+    this->iNumRows    = 0;
+}
+
+
+void AnomalyDetector::checkEvent (sRuleState_t& sState, const sAnomalyRule_t& sRule, const eAnomalyType_t eType, const bool bFailed,
+                                  const qint64 tTimeStamp, const int iRow, const double dValue, const double dScore)
+{
+    // declaration of variables
+    sAnomalyEvent_t sEvent;
+
+    if ((bFailed == true) && (sState.abActive [eType] == false))
+    {
+        sEvent.tTimeStamp  = tTimeStamp;
+        sEvent.iRow        = iRow;
+        sEvent.qstrChannel = sRule.qstrChannel;
+        sEvent.eType       = eType;
+        sEvent.dValue      = dValue;
+        sEvent.dScore      = dScore;
+        this->qvecEvents.push_back (sEvent);
+    }
+
+    sState.abActive [eType] = bFailed;
+}
+
+
+void AnomalyDetector::addSample (const int iRule, const qint64 tTimeStamp, const int iRow, const double dValue)
+{
+    // declaration of variables
+    const sAnomalyRule_t& sRule  = this->qvecRules  [iRule];
+    sRuleState_t&         sState = this->qvecStates [iRule];
+    double                dStdDev;
+    double                dScore;
+    double                dDelta;
+    qint64                lliDelta;
+
+    if (std::isnan (dValue) == true)
+    {
+        return;
+    }
+
+    // limits
+    if ((std::isnan (sRule.dMinValue) == false) || (std::isnan (sRule.dMaxValue) == false))
+    {
+        this->checkEvent (sState, sRule, ANOMALY_LIMIT,
+                          (dValue < sRule.dMinValue) || (dValue > sRule.dMaxValue),
+                          tTimeStamp, iRow, dValue, dValue);
+    }
+
+    if (sState.iCount > 0)
+    {
+        // rate of change since the reference sample, it is measured once the window has passed or the value
+        // has changed by more than the min. change in the checked direction. a gap restarts the measurement,
+        // a change against the checked direction moves the reference (e.g. to the peak before a drop)
+        lliDelta = tTimeStamp - sState.tRateTimeStamp;
+        dDelta   = (sRule.iRateSign == 0) ? std::fabs (dValue - sState.dRateValue) : (dValue - sState.dRateValue) * sRule.iRateSign;
+        if (((tTimeStamp - sState.tLastTimeStamp) > this->lliMaxGapSeconds) || (dDelta < 0.0))
+        {
+            sState.dRateValue     = dValue;
+            sState.tRateTimeStamp = tTimeStamp;
+        }
+        else if (sRule.dMaxRate > 0.0)
+        {
+            if ((lliDelta > 0) && ((lliDelta >= this->lliRateWindowSeconds) || (dDelta >= sRule.dMinDelta)))
+            {
+                dScore = (dValue - sState.dRateValue) / ((double) lliDelta / 3600.0);
+                this->checkEvent (sState, sRule, ANOMALY_RATE, (dDelta / ((double) lliDelta / 3600.0)) > sRule.dMaxRate,
+                                  tTimeStamp, iRow, dValue, dScore);
+                sState.dRateValue     = dValue;
+                sState.tRateTimeStamp = tTimeStamp;
+            }
+        }
+
+        // z-score against the statistics before this sample
+        if ((sRule.dZThreshold > 0.0) && (sState.iCount >= AnomalyDetector::iWarmUpSamples))
+        {
+            dStdDev = qMax (std::sqrt (sState.dVariance), sRule.dMinStdDev);
+            dScore  = (dValue - sState.dMean) / dStdDev;
+            this->checkEvent (sState, sRule, ANOMALY_ZSCORE, std::fabs (dScore) > sRule.dZThreshold,
+                              tTimeStamp, iRow, dValue, dScore);
+        }
+    }
+
+    // update the EWMA statistics
+    if (sState.iCount == 0)
+    {
+        sState.dMean          = dValue;
+        sState.dVariance      = 0.0;
+        sState.dRateValue     = dValue;
+        sState.tRateTimeStamp = tTimeStamp;
+    }
+    else
+    {
+        dDelta           = dValue - sState.dMean;
+        sState.dMean    += sRule.dAlpha * dDelta;
+        sState.dVariance = (1.0 - sRule.dAlpha) * (sState.dVariance + (sRule.dAlpha * dDelta * dDelta));
+    }
+
+    sState.iCount++;
+    sState.dLastValue     = dValue;
+    sState.tLastTimeStamp = tTimeStamp;
+}
+
+
+void AnomalyDetector::update (const TelemetrySeries& clSeries)
+{
+    // declaration of variables
+    const QVector<qint64>& qvecTimeStamps = clSeries.timeStamps ();
+    int                    iRule;
+    int                    iRow;
+
+    if ((this->uiContentId != clSeries.contentId ()) || (this->iNumRows > clSeries.size ()))
+    {
+        this->reset ();
+        this->uiContentId = clSeries.contentId ();
+    }
+
+    for (iRule = 0; iRule < this->qvecRules.size (); iRule++)
+    {
+        const QVector<double>& qvecValues = clSeries.column (this->qvecRules [iRule].qstrChannel);
+
+        for (iRow = this->iNumRows; iRow < qvecValues.size (); iRow++)
+        {
+            this->addSample (iRule, qvecTimeStamps [iRow], iRow, qvecValues [iRow]);
+        }
+    }
+
+    this->iNumRows = clSeries.size ();
+}
+
+
+const QVector<sAnomalyEvent_t>& AnomalyDetector::events (void) const
+{
+    return (this->qvecEvents);
+}
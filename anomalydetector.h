@@ -0,0 +1,226 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file anomalydetector.h
+ *
+ * \brief contains the defintion of the AnomalyDetector class.
+ *
+ * ---
+ */
+
+
+#ifndef ANOMALYDETECTOR_H
+#define ANOMALYDETECTOR_H
+
+#include <QString>
+#include <QVector>
+
+#include "telemetrystore.h"
+
+
+/**
+ * types of anomalies.
+ */
+enum eAnomalyType_t
+{
+    ANOMALY_ZSCORE = 0,     ///< value deviates from the EWMA mean by more than n standard deviations
+    ANOMALY_RATE   = 1,     ///< value changes faster than the max. rate
+    ANOMALY_LIMIT  = 2      ///< value is outside of the min. / max. limits
+};
+
+
+/**
+ * detection rule for one channel. Thresholds <= 0 disable the check.
+ */
+typedef struct
+{
+    QString qstrChannel;    ///< channel name
+    double  dAlpha;         ///< EWMA smoothing factor (0.0 ... 1.0)
+    double  dZThreshold;    ///< max. z-score
+    double  dMinStdDev;     ///< min. standard deviation, avoids false alarms on quantised, constant values
+    double  dMaxRate;       ///< max. rate of change [unit / h]
+    double  dMinDelta;      ///< min. change, that is checked before the rate window has passed, avoids false alarms on quantised values
+    int     iRateSign;      ///< direction of the rate check: -1 falling, +1 rising, 0 both
+    double  dMinValue;      ///< min. value (ANOMALY_LIMIT), NaN = no limit
+    double  dMaxValue;      ///< max. value (ANOMALY_LIMIT), NaN = no limit
+} sAnomalyRule_t;
+
+
+/**
+ * detected anomaly.
+ */
+typedef struct
+{
+    qint64         tTimeStamp;  ///< timestamp of the sample
+    int            iRow;        ///< row index inside the series
+    QString        qstrChannel; ///< channel name
+    eAnomalyType_t eType;       ///< type of the anomaly
+    double         dValue;      ///< value of the sample
+    double         dScore;      ///< z-score, rate [unit / h] or value, depending on the type
+} sAnomalyEvent_t;
+
+
+/**
+ * \class AnomalyDetector
+ *
+ * \brief Streaming anomaly detection on the channels of a series.
+ *
+ * For every rule the detector keeps an exponentially weighted mean and variance,
+ * the last value and an "active" flag per anomaly type. Every sample is checked
+ * against the statistics before it is added, hence the work and memory per
+ * sample are O(1) and the detector can run during ingest and in live-tail mode.
+ * The rate of change is measured from a reference sample over a time window, so
+ * that a single step of a quantised value does not count as a fast change.
+ * An event is reported when a check starts to fail, not for every sample of a
+ * longer excursion.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class AnomalyDetector
+{
+    private:
+        /**
+         * state of a rule.
+         */
+        typedef struct
+        {
+            int    iCount;          ///< number of valid samples
+            double dMean;           ///< EWMA mean
+            double dVariance;       ///< EWMA variance
+            double dLastValue;      ///< last valid value
+            qint64 tLastTimeStamp;  ///< timestamp of last valid value
+            double dRateValue;      ///< value, the rate is measured from
+            qint64 tRateTimeStamp;  ///< timestamp, the rate is measured from
+            bool   abActive [3];    ///< anomaly active, one per type
+        } sRuleState_t;
+
+        /**
+         * number of samples, before the z-score check is enabled.
+         */
+        static const int iWarmUpSamples = 20;
+
+        /**
+         * max. distance of two samples for the rate check [s].
+         */
+        qint64 lliMaxGapSeconds;
+
+        /**
+         * time, the rate is measured over, unless the value changes by more than the
+         * min. change of the rule before [s].
+         */
+        qint64 lliRateWindowSeconds;
+
+        QVector<sAnomalyRule_t>  qvecRules;
+        QVector<sRuleState_t>    qvecStates;
+        QVector<sAnomalyEvent_t> qvecEvents;
+
+        /**
+         * series, that is tracked by update (), and number of processed rows.
+         */
+        quint64 uiContentId;
+        int     iNumRows;
+
+        /**
+         * \brief Reports an event, when the check starts to fail.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void checkEvent (sRuleState_t& sState, const sAnomalyRule_t& sRule, const eAnomalyType_t eType, const bool bFailed,
+                         const qint64 tTimeStamp, const int iRow, const double dValue, const double dScore);
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * Adds the default rules for the HW_STATUS channels: sudden battery voltage
+         * drops, overheating of system and sensor and current spikes.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        AnomalyDetector (void);
+
+        /**
+         * \brief Adds a rule, the detector is reset.
+         *
+         * @param[in] const sAnomalyRule_t& sRule = rule
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void addRule (const sAnomalyRule_t& sRule);
+
+        /**
+         * \brief Checks one sample of a rule.
+         *
+         * @param[in] const int iRule = rule index
+         * @param[in] const qint64 tTimeStamp = timestamp in epoch seconds
+         * @param[in] const int iRow = row index, only stored inside the events
+         * @param[in] const double dValue = value
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void addSample (const int iRule, const qint64 tTimeStamp, const int iRow, const double dValue);
+
+        /**
+         * \brief Checks the rows of a series, that have not been processed yet.
+         *
+         * If the series has been cleared since the last call, the detector is reset.
+         *
+         * @param[in] const TelemetrySeries& clSeries = series
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void update (const TelemetrySeries& clSeries);
+
+        /**
+         * \brief Returns all events.
+         *
+         * \return const QVector<sAnomalyEvent_t>& = events in order of detection
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const QVector<sAnomalyEvent_t>& events (void) const;
+
+        /**
+         * \brief Removes all events and statistics, the rules are kept.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void reset (void);
+};
+
+#endif // ANOMALYDETECTOR_H
@@ -37,6 +37,7 @@
 
 
 #include "dbinterface.h"
+#include "phasetimer.h"
 #include <QDebug>
 #include <QSqlQuery>
 #include <QSqlError>
@@ -69,7 +70,9 @@ DBInterface::~DBInterface (void)
 
 QSqlQuery DBInterface::execQuery (const QString qstrSqlStatement)
 {
-    QSqlQuery clSQLQuery = this->clDBConn.exec(qstrSqlStatement);
+    // the MySQL driver transfers the complete result, before exec () returns
+    PhaseTimer clTimer ("db_query");
+    QSqlQuery  clSQLQuery = this->clDBConn.exec(qstrSqlStatement);
 
     // check, if database connection is still alive. if not,
     // reopen database connection and execute query again.
@@ -0,0 +1,525 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file decompressingdevice.cpp
+ *
+ * \brief contains the implementation of the DecompressingDevice class.
+ *
+ * ---
+ */
+
+
+#include "decompressingdevice.h"
+
+#include <QFile>
+#include <QMutexLocker>
+
+#include <cstring>
+#include <vector>
+
+#include <zlib.h>
+
+#ifdef C_WITH_ZSTD
+    #include <zstd.h>
+#endif
+
+
+/**
+ * size of the blocks, that are read from the file, and of the decompressed chunks,
+ * max. number of decompressed chunks, that are queued.
+ */
+#define C_DECOMPRESS_BLOCK_SIZE (256 * 1024)
+#define C_DECOMPRESS_MAX_CHUNKS 16
+
+
+DecompressingDevice::DecompressingDevice (const QString& qstrFileNameRef, QSemaphore* pclIOLimitRef, QObject* pclParent) :
+    QIODevice (pclParent)
+{
+    this->qstrFileName   = qstrFileNameRef;
+    this->pclIOLimit     = pclIOLimitRef;
+    this->pclFile        = NULL;
+    this->eFormat        = FORMAT_PLAIN;
+    this->lliQueuedBytes = 0;
+    this->iMaxChunks     = C_DECOMPRESS_MAX_CHUNKS;
+    this->bFinished      = false;
+    this->bAbort         = false;
+    this->iCurrentPos    = 0;
+}
+
+
+DecompressingDevice::~DecompressingDevice (void)
+{
+    this->close ();
+}
+
+
+DecompressingDevice::eCompression_t DecompressingDevice::detectFormat (const QByteArray& qbaHeader)
+{
+    // declaration of variables
+    const unsigned char* pucHeader = (const unsigned char*) qbaHeader.constData ();
+
+    if ((qbaHeader.size () >= 2) && (pucHeader [0] == 0x1F) && (pucHeader [1] == 0x8B))
+    {
+        return (FORMAT_GZIP);
+    }
+
+    if ((qbaHeader.size () >= 4) && (pucHeader [0] == 0x28) && (pucHeader [1] == 0xB5) &&
+        (pucHeader [2] == 0x2F) && (pucHeader [3] == 0xFD))
+    {
+        return (FORMAT_ZSTD);
+    }
+
+    return (FORMAT_PLAIN);
+}
+
+
+DecompressingDevice::eCompression_t DecompressingDevice::format (void) const
+{
+    return (this->eFormat);
+}
+
+
+bool DecompressingDevice::open (OpenMode eMode)
+{
+    // declaration of variables
+    QFile* pclNewFile;
+
+    if ((this->isOpen () == true) || ((eMode & QIODevice::WriteOnly) != 0))
+    {
+        return (false);
+    }
+
+    pclNewFile = new QFile (this->qstrFileName);
+    if (pclNewFile->open (QIODevice::ReadOnly) == false)
+    {
+        this->setErrorString (pclNewFile->errorString ());
+        delete (pclNewFile);
+        return (false);
+    }
+
+    this->eFormat = DecompressingDevice::detectFormat (pclNewFile->peek (4));
+
+    #ifndef C_WITH_ZSTD
+        if (this->eFormat == FORMAT_ZSTD)
+        {
+            this->setErrorString ("zstd compressed files are not supported by this build");
+            delete (pclNewFile);
+            return (false);
+        }
+    #endif
+
+    this->pclFile        = pclNewFile;
+    this->lliQueuedBytes = 0;
+    this->bFinished      = false;
+    this->bAbort         = false;
+    this->iCurrentPos    = 0;
+    this->qbaCurrent.clear ();
+    this->qqueueChunks.clear ();
+    this->qstrError.clear ();
+
+    QIODevice::open (QIODevice::ReadOnly);
+
+    // the file is only used by the pipeline thread from now on
+    this->clThread = std::thread (&DecompressingDevice::run, this);
+
+    return (true);
+}
+
+
+void DecompressingDevice::close (void)
+{
+    if (this->clThread.joinable () == true)
+    {
+        this->clMutex.lock ();
+        this->bAbort = true;
+        this->clNotFull.wakeAll ();
+        this->clMutex.unlock ();
+
+        this->clThread.join ();
+    }
+
+    delete (this->pclFile);
+    this->pclFile = NULL;
+    this->qqueueChunks.clear ();
+    this->qbaCurrent.clear ();
+    this->lliQueuedBytes = 0;
+    this->iCurrentPos    = 0;
+
+    if (this->isOpen () == true)
+    {
+        QIODevice::close ();
+    }
+}
+
+
+bool DecompressingDevice::isSequential (void) const
+{
+    return (true);
+}
+
+
+bool DecompressingDevice::atEnd (void) const
+{
+    // declaration of variables
+    QMutexLocker clLocker (&this->clMutex);
+
+    return ((this->isOpen () == false) ||
+            ((QIODevice::bytesAvailable () == 0)                 &&
+             (this->iCurrentPos >= this->qbaCurrent.size ())     &&
+             (this->qqueueChunks.isEmpty () == true)             &&
+             (this->bFinished == true)));
+}
+
+
+qint64 DecompressingDevice::bytesAvailable (void) const
+{
+    // declaration of variables
+    QMutexLocker clLocker (&this->clMutex);
+
+    return (QIODevice::bytesAvailable () + (this->qbaCurrent.size () - this->iCurrentPos) + this->lliQueuedBytes);
+}
+
+
+qint64 DecompressingDevice::readData (char* pcData, qint64 lliMaxSize)
+{
+    // declaration of variables
+    qint64 lliRead = 0;
+    qint64 lliSize;
+
+    while (lliRead < lliMaxSize)
+    {
+        if (this->iCurrentPos >= this->qbaCurrent.size ())
+        {
+            QMutexLocker clLocker (&this->clMutex);
+
+            // blocks only, as long as nothing has been read
+            while ((this->qqueueChunks.isEmpty () == true) && (this->bFinished == false) && (lliRead == 0))
+            {
+                this->clNotEmpty.wait (&this->clMutex);
+            }
+
+            if (this->qqueueChunks.isEmpty () == true)
+            {
+                if ((lliRead == 0) && (this->qstrError.isEmpty () == false))
+                {
+                    this->setErrorString (this->qstrError);
+                    return (-1);
+                }
+                break;
+            }
+
+            this->qbaCurrent      = this->qqueueChunks.dequeue ();
+            this->iCurrentPos     = 0;
+            this->lliQueuedBytes -= this->qbaCurrent.size ();
+            this->clNotFull.wakeOne ();
+        }
+
+        lliSize = qMin (lliMaxSize - lliRead, (qint64) (this->qbaCurrent.size () - this->iCurrentPos));
+        memcpy (pcData + lliRead, this->qbaCurrent.constData () + this->iCurrentPos, lliSize);
+        this->iCurrentPos += lliSize;
+        lliRead           += lliSize;
+    }
+
+    return (lliRead);
+}
+
+
+qint64 DecompressingDevice::writeData (const char* pcData, qint64 lliMaxSize)
+{
+    Q_UNUSED (pcData);
+    Q_UNUSED (lliMaxSize);
+
+    return (-1);
+}
+
+
+void DecompressingDevice::run (void)
+{
+    // declaration of variables
+    QString qstrErrorText;
+
+    switch (this->eFormat)
+    {
+        case FORMAT_GZIP:
+            qstrErrorText = this->runGzip ();
+            break;
+
+        case FORMAT_ZSTD:
+            qstrErrorText = this->runZstd ();
+            break;
+
+        default:
+            qstrErrorText = this->runPlain ();
+            break;
+    }
+
+    this->finish (qstrErrorText);
+}
+
+
+qint64 DecompressingDevice::readBlock (char* pcBuffer, const qint64 lliMaxSize)
+{
+    // declaration of variables
+    qint64 lliRead;
+
+    if (this->pclIOLimit != NULL)
+    {
+        this->pclIOLimit->acquire ();
+    }
+
+    lliRead = this->pclFile->read (pcBuffer, lliMaxSize);
+
+    if (this->pclIOLimit != NULL)
+    {
+        this->pclIOLimit->release ();
+    }
+
+    return (lliRead);
+}
+
+
+bool DecompressingDevice::push (const QByteArray& qbaChunk)
+{
+    // declaration of variables
+    QMutexLocker clLocker (&this->clMutex);
+
+    while ((this->qqueueChunks.size () >= this->iMaxChunks) && (this->bAbort == false))
+    {
+        this->clNotFull.wait (&this->clMutex);
+    }
+
+    if (this->bAbort == true)
+    {
+        return (false);
+    }
+
+    this->qqueueChunks.enqueue (qbaChunk);
+    this->lliQueuedBytes += qbaChunk.size ();
+    this->clNotEmpty.wakeOne ();
+
+    return (true);
+}
+
+
+void DecompressingDevice::finish (const QString& qstrErrorText)
+{
+    // declaration of variables
+    QMutexLocker clLocker (&this->clMutex);
+
+    this->bFinished = true;
+    this->qstrError = qstrErrorText;
+    this->clNotEmpty.wakeAll ();
+}
+
+
+QString DecompressingDevice::runPlain (void)
+{
+    // declaration of variables
+    QByteArray qbaBlock;
+    qint64     lliRead;
+
+    while (true)
+    {
+        qbaBlock.resize (C_DECOMPRESS_BLOCK_SIZE);
+        lliRead = this->readBlock (qbaBlock.data (), qbaBlock.size ());
+        if (lliRead < 0)
+        {
+            return (this->pclFile->errorString ());
+        }
+        if (lliRead == 0)
+        {
+            break;
+        }
+
+        qbaBlock.resize (lliRead);
+        if (this->push (qbaBlock) == false)
+        {
+            break;
+        }
+    }
+
+    return (QString ());
+}
+
+
+QString DecompressingDevice::runGzip (void)
+{
+    // declaration of variables
+    z_stream          sStream;
+    std::vector<char> vecInput (C_DECOMPRESS_BLOCK_SIZE);
+    QByteArray        qbaOutput;
+    QString           qstrErrorText;
+    qint64            lliRead;
+    int               iResult = Z_OK;
+    int               iProduced;
+
+    memset (&sStream, 0, sizeof (sStream));
+
+    // window size 15, + 32: detect gzip / zlib header
+    if (inflateInit2 (&sStream, 15 + 32) != Z_OK)
+    {
+        return (QStringLiteral ("unable to initialise zlib"));
+    }
+
+    while (qstrErrorText.isEmpty () == true)
+    {
+        lliRead = this->readBlock (vecInput.data (), vecInput.size ());
+        if (lliRead < 0)
+        {
+            qstrErrorText = this->pclFile->errorString ();
+            break;
+        }
+        if (lliRead == 0)
+        {
+            if (iResult != Z_STREAM_END)
+            {
+                qstrErrorText = QStringLiteral ("unexpected end of gzip data");
+            }
+            break;
+        }
+
+        sStream.next_in  = (Bytef*) vecInput.data ();
+        sStream.avail_in = (uInt) lliRead;
+
+        // inflate, until the input block is used and the output buffer is not filled completely
+        do
+        {
+            // concatenated gzip members (e.g. appended archives) follow each other
+            if (iResult == Z_STREAM_END)
+            {
+                inflateReset (&sStream);
+            }
+
+            qbaOutput.resize (C_DECOMPRESS_BLOCK_SIZE);
+            sStream.next_out  = (Bytef*) qbaOutput.data ();
+            sStream.avail_out = (uInt) qbaOutput.size ();
+
+            iResult = inflate (&sStream, Z_NO_FLUSH);
+            if (iResult == Z_BUF_ERROR)
+            {
+                // no progress possible without further input
+                iResult = Z_OK;
+                break;
+            }
+            if ((iResult != Z_OK) && (iResult != Z_STREAM_END))
+            {
+                qstrErrorText = QString ("gzip data error: %1").arg (sStream.msg != NULL ? sStream.msg : "unknown");
+                break;
+            }
+
+            iProduced = qbaOutput.size () - (int) sStream.avail_out;
+            if (iProduced > 0)
+            {
+                qbaOutput.resize (iProduced);
+                if (this->push (qbaOutput) == false)
+                {
+                    inflateEnd (&sStream);
+                    return (QString ());
+                }
+            }
+        } while ((sStream.avail_in > 0) || ((sStream.avail_out == 0) && (iResult != Z_STREAM_END)));
+    }
+
+    inflateEnd (&sStream);
+
+    return (qstrErrorText);
+}
+
+
+QString DecompressingDevice::runZstd (void)
+{
+    // declaration of variables
+    QString qstrErrorText;
+
+    #ifdef C_WITH_ZSTD
+        ZSTD_DStream*     pclStream = ZSTD_createDStream ();
+        std::vector<char> vecInput (C_DECOMPRESS_BLOCK_SIZE);
+        QByteArray        qbaOutput;
+        qint64            lliRead;
+        size_t            uiResult = 0;
+
+        ZSTD_initDStream (pclStream);
+
+        while (qstrErrorText.isEmpty () == true)
+        {
+            lliRead = this->readBlock (vecInput.data (), vecInput.size ());
+            if (lliRead < 0)
+            {
+                qstrErrorText = this->pclFile->errorString ();
+                break;
+            }
+            if (lliRead == 0)
+            {
+                // 0: the last frame is complete
+                if (uiResult != 0)
+                {
+                    qstrErrorText = QStringLiteral ("unexpected end of zstd data");
+                }
+                break;
+            }
+
+            ZSTD_inBuffer sInput = {vecInput.data (), (size_t) lliRead, 0};
+
+            while (true)
+            {
+                qbaOutput.resize (C_DECOMPRESS_BLOCK_SIZE);
+                ZSTD_outBuffer sOutput = {qbaOutput.data (), (size_t) qbaOutput.size (), 0};
+
+                uiResult = ZSTD_decompressStream (pclStream, &sOutput, &sInput);
+                if (ZSTD_isError (uiResult) != 0)
+                {
+                    qstrErrorText = QString ("zstd data error: %1").arg (ZSTD_getErrorName (uiResult));
+                    break;
+                }
+
+                if (sOutput.pos > 0)
+                {
+                    qbaOutput.resize ((int) sOutput.pos);
+                    if (this->push (qbaOutput) == false)
+                    {
+                        ZSTD_freeDStream (pclStream);
+                        return (QString ());
+                    }
+                }
+
+                if ((sInput.pos == sInput.size) && (sOutput.pos < sOutput.size))
+                {
+                    break;
+                }
+            }
+        }
+
+        ZSTD_freeDStream (pclStream);
+    #else
+        qstrErrorText = QStringLiteral ("zstd compressed files are not supported by this build");
+    #endif
+
+    return (qstrErrorText);
+}
@@ -0,0 +1,244 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file decompressingdevice.h
+ *
+ * \brief contains the defintion of the DecompressingDevice class.
+ *
+ * ---
+ */
+
+
+#ifndef DECOMPRESSINGDEVICE_H
+#define DECOMPRESSINGDEVICE_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QString>
+#include <QQueue>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSemaphore>
+
+#include <thread>
+
+
+#define C_DECOMPRESSING_DEVICE_NAME "DecompressingDevice"
+
+
+/**
+ * \class DecompressingDevice
+ *
+ * \brief Read-only sequential device, that decompresses a file on the fly.
+ *
+ * The compression is detected from the magic bytes at the start of the file:
+ * gzip (also concatenated members), zstd (only if built with C_WITH_ZSTD) or
+ * uncompressed. Reading and decompressing runs in a separate pipeline thread,
+ * that fills a bounded queue of decompressed chunks, hence decompression overlaps
+ * with the parser, that reads from the device. Neither the compressed nor the
+ * decompressed file is ever held completely in memory or written to disk.
+ * read () blocks until data is available or the end of the file is reached.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class DecompressingDevice : public QIODevice
+{
+    Q_OBJECT
+
+    public:
+        /**
+         * compression formats.
+         */
+        typedef enum
+        {
+            FORMAT_PLAIN = 0,   ///< uncompressed
+            FORMAT_GZIP  = 1,   ///< gzip (RFC 1952)
+            FORMAT_ZSTD  = 2    ///< zstandard
+        } eCompression_t;
+
+    private:
+        /**
+         * file name, compression format and file, the file is only used by the pipeline thread.
+         */
+        QString        qstrFileName;
+        eCompression_t eFormat;
+        QIODevice*     pclFile;
+
+        /**
+         * optional limit for concurrent file reads, shared by several devices.
+         */
+        QSemaphore* pclIOLimit;
+
+        /**
+         * queue of decompressed chunks and its synchronisation.
+         */
+        mutable QMutex     clMutex;
+        QWaitCondition     clNotEmpty;
+        QWaitCondition     clNotFull;
+        QQueue<QByteArray> qqueueChunks;
+        qint64             lliQueuedBytes;
+        int                iMaxChunks;
+        bool               bFinished;
+        bool               bAbort;
+        QString            qstrError;
+
+        /**
+         * chunk, that is currently read and read position inside it (reader side only).
+         */
+        QByteArray qbaCurrent;
+        int        iCurrentPos;
+
+        /**
+         * pipeline thread.
+         */
+        std::thread clThread;
+
+        /**
+         * \brief Body of the pipeline thread.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void run (void);
+
+        /**
+         * \brief Reads the next block of the compressed file.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        qint64 readBlock (char* pcBuffer, const qint64 lliMaxSize);
+
+        /**
+         * \brief Appends a decompressed chunk to the queue, waits while the queue is full.
+         *
+         * \return bool = true: OK / false: the device has been closed
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool push (const QByteArray& qbaChunk);
+
+        /**
+         * \brief Marks the end of the data (and an error, if any) and wakes up the reader.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void finish (const QString& qstrErrorText);
+
+        /**
+         * \brief Reads and decompresses the file, one function per format.
+         *
+         * \return QString = error text / empty string: OK
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QString runPlain (void);
+        QString runGzip  (void);
+        QString runZstd  (void);
+
+    protected:
+        qint64 readData  (char* pcData, qint64 lliMaxSize) override;
+        qint64 writeData (const char* pcData, qint64 lliMaxSize) override;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const QString& qstrFileNameRef = file name
+         * @param[in] QSemaphore* pclIOLimitRef = limit for concurrent file reads, may be NULL
+         * @param[in] QObject* pclParent = parent object
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        DecompressingDevice (const QString& qstrFileNameRef, QSemaphore* pclIOLimitRef = NULL, QObject* pclParent = NULL);
+
+        /**
+         * \brief This is the class destructor.
+         *
+         * Stops the pipeline thread.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        ~DecompressingDevice (void);
+
+        /**
+         * \brief Detects the compression format from the first bytes of a file.
+         *
+         * @param[in] const QByteArray& qbaHeader = first (min. 4) bytes of the file
+         * \return eCompression_t = compression format
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static eCompression_t detectFormat (const QByteArray& qbaHeader);
+
+        /**
+         * \brief Returns the compression format of the opened file.
+         *
+         * \return eCompression_t = compression format
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        eCompression_t format (void) const;
+
+        /**
+         * \brief Opens the file and starts the pipeline thread, only ReadOnly is supported.
+         *
+         * @param[in] OpenMode eMode = open mode
+         * \return bool = true: OK / false: unable to open the file or unsupported format
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool open (OpenMode eMode) override;
+
+        /**
+         * \brief Stops the pipeline thread and closes the file.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void close (void) override;
+
+        bool   isSequential   (void) const override;
+        bool   atEnd          (void) const override;
+        qint64 bytesAvailable (void) const override;
+};
+
+#endif // DECOMPRESSINGDEVICE_H
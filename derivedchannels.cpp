@@ -0,0 +1,640 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file derivedchannels.cpp
+ *
+ * \brief contains the implementation of the DerivedChannels class.
+ *
+ * ---
+ */
+
+
+#include "derivedchannels.h"
+#include "energyanalytics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+
+DerivedChannels::DerivedChannels (void)
+{
+    this->define ("power",      "(batt1_curr + batt2_curr) * batt_volt");
+    this->define ("energy",     "integral (power)");
+    this->define ("temp_delta", "temp - temp_sensor");
+}
+
+
+bool DerivedChannels::compile (const QString& qstrExpression, QVector<sOperation_t>& qvecProgram, QString& qstrError)
+{
+    /**
+     * recursive descent parser, emits the operations in postfix order:
+     *
+     * expression = term { ("+" | "-") term }
+     * term       = factor { ("*" | "/") factor }
+     * factor     = ("-" | "+") factor | number | "(" expression ")" | name [ "(" expression ")" ]
+     */
+    struct sParser_t
+    {
+        const QString&         qstrText;
+        int                    iPos;
+        QVector<sOperation_t>& qvecOut;
+        QString&               qstrErr;
+
+        void push (const eOperation_t eOperation, const double dValue = 0.0, const QString& qstrChannel = QString ())
+        {
+            sOperation_t sOperation;
+
+            sOperation.eOperation  = eOperation;
+            sOperation.dValue      = dValue;
+            sOperation.qstrChannel = qstrChannel;
+            qvecOut.push_back (sOperation);
+        }
+
+        QChar peek (void)
+        {
+            while ((iPos < qstrText.size ()) && (qstrText [iPos].isSpace () == true))
+            {
+                iPos++;
+            }
+            return ((iPos < qstrText.size ()) ? qstrText [iPos] : QChar ());
+        }
+
+        bool fail (const QString& qstrMessage)
+        {
+            qstrErr = qstrMessage + " at position " + QString::number (iPos);
+            return (false);
+        }
+
+        bool expression (void)
+        {
+            QChar qcOperator;
+
+            if (term () == false)
+            {
+                return (false);
+            }
+            for (qcOperator = peek (); (qcOperator == '+') || (qcOperator == '-'); qcOperator = peek ())
+            {
+                iPos++;
+                if (term () == false)
+                {
+                    return (false);
+                }
+                push ((qcOperator == '+') ? OP_ADD : OP_SUB);
+            }
+            return (true);
+        }
+
+        bool term (void)
+        {
+            QChar qcOperator;
+
+            if (factor () == false)
+            {
+                return (false);
+            }
+            for (qcOperator = peek (); (qcOperator == '*') || (qcOperator == '/'); qcOperator = peek ())
+            {
+                iPos++;
+                if (factor () == false)
+                {
+                    return (false);
+                }
+                push ((qcOperator == '*') ? OP_MUL : OP_DIV);
+            }
+            return (true);
+        }
+
+        bool factor (void)
+        {
+            // declaration of variables
+            QChar   qcNext = peek ();
+            int     iStart = iPos;
+            bool    bOk    = false;
+            double  dValue;
+            QString qstrName;
+
+            if (qcNext.isNull () == true)
+            {
+                return (fail ("unexpected end of expression"));
+            }
+
+            if ((qcNext == '-') || (qcNext == '+'))
+            {
+                iPos++;
+                if (factor () == false)
+                {
+                    return (false);
+                }
+                if (qcNext == '-')
+                {
+                    push (OP_NEG);
+                }
+                return (true);
+            }
+
+            if (qcNext == '(')
+            {
+                iPos++;
+                if (expression () == false)
+                {
+                    return (false);
+                }
+                if (peek () != ')')
+                {
+                    return (fail ("missing )"));
+                }
+                iPos++;
+                return (true);
+            }
+
+            if ((qcNext.isDigit () == true) || (qcNext == '.'))
+            {
+                while ((iPos < qstrText.size ()) &&
+                       ((qstrText [iPos].isDigit () == true) || (qstrText [iPos] == '.') ||
+                        (qstrText [iPos] == 'e') || (qstrText [iPos] == 'E') ||
+                        (((qstrText [iPos] == '-') || (qstrText [iPos] == '+')) &&
+                         ((qstrText [iPos - 1] == 'e') || (qstrText [iPos - 1] == 'E')))))
+                {
+                    iPos++;
+                }
+                dValue = qstrText.mid (iStart, iPos - iStart).toDouble (&bOk);
+                if (bOk == false)
+                {
+                    iPos = iStart;
+                    return (fail ("invalid number"));
+                }
+                push (OP_CONST, dValue);
+                return (true);
+            }
+
+            if ((qcNext.isLetter () == true) || (qcNext == '_'))
+            {
+                while ((iPos < qstrText.size ()) && ((qstrText [iPos].isLetterOrNumber () == true) || (qstrText [iPos] == '_')))
+                {
+                    iPos++;
+                }
+                qstrName = qstrText.mid (iStart, iPos - iStart);
+
+                if (peek () != '(')
+                {
+                    push (OP_CHANNEL, 0.0, qstrName);
+                    return (true);
+                }
+
+                iPos++;
+                if (expression () == false)
+                {
+                    return (false);
+                }
+                if (peek () != ')')
+                {
+                    return (fail ("missing )"));
+                }
+                iPos++;
+
+                if (qstrName == "abs")
+                {
+                    push (OP_ABS);
+                }
+                else if (qstrName == "diff")
+                {
+                    push (OP_DIFF);
+                }
+                else if (qstrName == "integral")
+                {
+                    push (OP_INTEGRAL);
+                }
+                else
+                {
+                    iPos = iStart;
+                    return (fail ("unknown function " + qstrName));
+                }
+                return (true);
+            }
+
+            return (fail ("unexpected character"));
+        }
+    };
+
+    // declaration of variables
+    sParser_t sParser = {qstrExpression, 0, qvecProgram, qstrError};
+
+    qvecProgram.clear ();
+    qstrError.clear   ();
+
+    if (sParser.expression () == false)
+    {
+        qvecProgram.clear ();
+        return (false);
+    }
+
+    if (sParser.peek ().isNull () == false)
+    {
+        qvecProgram.clear ();
+        return (sParser.fail ("unexpected character"));
+    }
+
+    return (true);
+}
+
+
+bool DerivedChannels::define (const QString& qstrChannel, const QString& qstrExpression, QString* pqstrError)
+{
+    // declaration of variables
+    QVector<sOperation_t> qvecProgram;
+    QString               qstrError;
+
+    if (DerivedChannels::compile (qstrExpression, qvecProgram, qstrError) == false)
+    {
+        #ifdef C_DERIVED_CHANNELS_DEBUG_MSG
+            printf ("[%s] invalid expression for %s: %s\n", C_DERIVED_CHANNELS_NAME,
+                    qstrChannel.toStdString ().c_str (), qstrError.toStdString ().c_str ());
+            fflush (stdout);
+        #endif
+
+        if (pqstrError != NULL)
+        {
+            *pqstrError = qstrError;
+        }
+        return (false);
+    }
+
+    this->qhashExpressions.insert (qstrChannel, qstrExpression);
+    this->qhashPrograms.insert    (qstrChannel, qvecProgram);
+
+    // other derived channels may use this one
+    this->clearCache ();
+
+    return (true);
+}
+
+
+bool DerivedChannels::contains (const QString& qstrChannel) const
+{
+    return (this->qhashPrograms.contains (qstrChannel));
+}
+
+
+QStringList DerivedChannels::names (void) const
+{
+    return (this->qhashExpressions.keys ());
+}
+
+
+void DerivedChannels::evaluateBlock (const QVector<sOperation_t>& qvecProgram, const std::vector<const double*>& vecSources,
+                                     const qint64* ptTimeStamps, std::vector<sOperationState_t>& vecState,
+                                     const int iStart, const int iCount, double* pdResult)
+{
+    // declaration of variables
+    const double dNaN = std::numeric_limits<double>::quiet_NaN ();
+    size_t       uiTop = 0;
+    int          iOperation;
+    int          iCounter;
+    double*      pdA;
+    double*      pdB;
+    double       dValue;
+    qint64       lliDelta;
+
+    for (iOperation = 0; iOperation < qvecProgram.size (); iOperation++)
+    {
+        const sOperation_t& sOperation = qvecProgram [iOperation];
+        sOperationState_t&  sState     = vecState [iOperation];
+
+        switch (sOperation.eOperation)
+        {
+            case OP_CONST:
+                pdA = this->vecStack [uiTop++].data ();
+                std::fill (pdA, pdA + iCount, sOperation.dValue);
+                break;
+
+            case OP_CHANNEL:
+                pdA = this->vecStack [uiTop++].data ();
+                if (vecSources [iOperation] != NULL)
+                {
+                    std::copy (vecSources [iOperation] + iStart, vecSources [iOperation] + iStart + iCount, pdA);
+                }
+                else
+                {
+                    std::fill (pdA, pdA + iCount, dNaN);
+                }
+                break;
+
+            case OP_ADD:
+            case OP_SUB:
+            case OP_MUL:
+            case OP_DIV:
+                pdA = this->vecStack [uiTop - 2].data ();
+                pdB = this->vecStack [uiTop - 1].data ();
+                uiTop--;
+                if (sOperation.eOperation == OP_ADD)
+                {
+                    for (iCounter = 0; iCounter < iCount; iCounter++) { pdA [iCounter] += pdB [iCounter]; }
+                }
+                else if (sOperation.eOperation == OP_SUB)
+                {
+                    for (iCounter = 0; iCounter < iCount; iCounter++) { pdA [iCounter] -= pdB [iCounter]; }
+                }
+                else if (sOperation.eOperation == OP_MUL)
+                {
+                    for (iCounter = 0; iCounter < iCount; iCounter++) { pdA [iCounter] *= pdB [iCounter]; }
+                }
+                else
+                {
+                    for (iCounter = 0; iCounter < iCount; iCounter++) { pdA [iCounter] /= pdB [iCounter]; }
+                }
+                break;
+
+            case OP_NEG:
+                pdA = this->vecStack [uiTop - 1].data ();
+                for (iCounter = 0; iCounter < iCount; iCounter++) { pdA [iCounter] = -pdA [iCounter]; }
+                break;
+
+            case OP_ABS:
+                pdA = this->vecStack [uiTop - 1].data ();
+                for (iCounter = 0; iCounter < iCount; iCounter++) { pdA [iCounter] = std::fabs (pdA [iCounter]); }
+                break;
+
+            case OP_DIFF:
+                // backwards, hence every row still sees the unmodified previous value
+                pdA    = this->vecStack [uiTop - 1].data ();
+                dValue = pdA [iCount - 1];
+                for (iCounter = iCount - 1; iCounter > 0; iCounter--) { pdA [iCounter] -= pdA [iCounter - 1]; }
+                pdA [0]          -= sState.dLastValue;
+                sState.dLastValue = dValue;
+                break;
+
+            case OP_INTEGRAL:
+                // trapezoid rule, intervals with a NaN value at either end and gaps are skipped
+                pdA = this->vecStack [uiTop - 1].data ();
+                for (iCounter = 0; iCounter < iCount; iCounter++)
+                {
+                    dValue   = pdA [iCounter];
+                    lliDelta = ptTimeStamps [iStart + iCounter] - sState.tLastTimeStamp;
+                    EnergyAnalytics::integrate (sState.dLastValue, dValue, lliDelta, C_ENERGY_MAX_GAP_SECONDS, sState.dSum);
+                    sState.dLastValue     = dValue;
+                    sState.tLastTimeStamp = ptTimeStamps [iStart + iCounter];
+                    pdA [iCounter]        = sState.dSum;
+                }
+                break;
+        }
+    }
+
+    std::copy (this->vecStack [0].data (), this->vecStack [0].data () + iCount, pdResult);
+}
+
+
+DerivedChannels::sChannelCache_t* DerivedChannels::update (const TelemetrySeries& clSeries, const QString& qstrChannel)
+{
+    // declaration of variables
+    QString                          qstrKey = clSeries.component () + "/" + qstrChannel;
+    QSharedPointer<sChannelCache_t>  pclCache;
+    QVector<sOperation_t>            qvecProgram;
+    QVector<QVector<double> >        qvecDependencies;
+    std::vector<const double*>       vecSources;
+    sChannelCache_t*                 pclDependency;
+    sOperationState_t                sInitialState;
+    int                              iCounter;
+    int                              iStart;
+
+    if (this->qhashPrograms.contains (qstrChannel) == false)
+    {
+        return (NULL);
+    }
+    qvecProgram = this->qhashPrograms.value (qstrChannel);
+
+    pclCache = this->qhashCache.value (qstrKey);
+    if (pclCache.isNull () == true)
+    {
+        pclCache = QSharedPointer<sChannelCache_t> (new sChannelCache_t);
+        pclCache->uiContentId = 0;
+        pclCache->bBusy       = false;
+        this->qhashCache.insert (qstrKey, pclCache);
+    }
+
+    if (pclCache->bBusy == true)
+    {
+        #ifdef C_DERIVED_CHANNELS_DEBUG_MSG
+            printf ("[%s] cyclic definition of %s\n", C_DERIVED_CHANNELS_NAME, qstrChannel.toStdString ().c_str ());
+            fflush (stdout);
+        #endif
+        return (NULL);
+    }
+
+    // restart, if the rows of the series have been replaced
+    if ((pclCache->uiContentId != clSeries.contentId ()) || (pclCache->iNumRows > clSeries.size ()))
+    {
+        sInitialState.dLastValue     = std::numeric_limits<double>::quiet_NaN ();
+        sInitialState.tLastTimeStamp = 0;
+        sInitialState.dSum           = 0.0;
+
+        pclCache->uiContentId  = clSeries.contentId ();
+        pclCache->iNumRows     = 0;
+        pclCache->iNumTierRows   = 0;
+        pclCache->iNumSketchRows = 0;
+        pclCache->qvecValues.clear ();
+        pclCache->qmapDaySketches.clear ();
+        pclCache->vecState.assign (qvecProgram.size (), sInitialState);
+        pclCache->qvecTiers.clear ();
+        for (iCounter = 0; iCounter < TelemetrySeries::iNumTiers; iCounter++)
+        {
+            pclCache->qvecTiers.push_back (TelemetryTier (TelemetrySeries::alliTierSeconds [iCounter]));
+            pclCache->qvecTiers.last ().reset (1);
+        }
+    }
+
+    if (pclCache->iNumRows == clSeries.size ())
+    {
+        return (pclCache.data ());
+    }
+
+    // resolve the columns of the operands, derived channels are brought up to date first
+    pclCache->bBusy = true;
+    vecSources.assign (qvecProgram.size (), NULL);
+    qvecDependencies.reserve (qvecProgram.size ());
+    for (iCounter = 0; iCounter < qvecProgram.size (); iCounter++)
+    {
+        if (qvecProgram [iCounter].eOperation == OP_CHANNEL)
+        {
+            if (clSeries.channelIndex (qvecProgram [iCounter].qstrChannel) >= 0)
+            {
+                vecSources [iCounter] = clSeries.column (qvecProgram [iCounter].qstrChannel).constData ();
+            }
+            else
+            {
+                pclDependency = this->update (clSeries, qvecProgram [iCounter].qstrChannel);
+                if (pclDependency != NULL)
+                {
+                    qvecDependencies.push_back (pclDependency->qvecValues);
+                    vecSources [iCounter] = qvecDependencies.last ().constData ();
+                }
+            }
+        }
+    }
+
+    if (this->vecStack.size () < (size_t) qvecProgram.size ())
+    {
+        this->vecStack.resize (qvecProgram.size (), std::vector<double> (DerivedChannels::iBlockSize));
+    }
+
+    pclCache->qvecValues.resize (clSeries.size ());
+    for (iStart = pclCache->iNumRows; iStart < clSeries.size (); iStart += DerivedChannels::iBlockSize)
+    {
+        this->evaluateBlock (qvecProgram, vecSources, clSeries.timeStamps ().constData (), pclCache->vecState,
+                             iStart, qMin (DerivedChannels::iBlockSize, clSeries.size () - iStart),
+                             pclCache->qvecValues.data () + iStart);
+    }
+    pclCache->iNumRows = clSeries.size ();
+    pclCache->bBusy    = false;
+
+    return (pclCache.data ());
+}
+
+
+const QVector<double>& DerivedChannels::column (const TelemetrySeries& clSeries, const QString& qstrChannel)
+{
+    // declaration of variables
+    static const QVector<double> qvecEmpty;
+    sChannelCache_t* pclCache = this->update (clSeries, qstrChannel);
+
+    if (pclCache == NULL)
+    {
+        return (qvecEmpty);
+    }
+
+    return (pclCache->qvecValues);
+}
+
+
+const TelemetryTier& DerivedChannels::tier (const TelemetrySeries& clSeries, const QString& qstrChannel, const int iTier)
+{
+    // declaration of variables
+    static const TelemetryTier clEmpty;
+    sChannelCache_t*           pclCache = this->update (clSeries, qstrChannel);
+    QVector<QVector<double> >  qvecColumns;
+    QVector<int>               qvecRows;
+    const QVector<qint64>&     qvecTimeStamps = clSeries.timeStamps ();
+    int                        iRow;
+    bool                       bInOrder = true;
+
+    if (pclCache == NULL)
+    {
+        return (clEmpty);
+    }
+
+    if (pclCache->iNumTierRows < pclCache->iNumRows)
+    {
+        qvecColumns.push_back (pclCache->qvecValues);
+
+        for (iRow = pclCache->iNumTierRows; (iRow < pclCache->iNumRows) && (bInOrder == true); iRow++)
+        {
+            for (TelemetryTier& clTier : pclCache->qvecTiers)
+            {
+                bInOrder = bInOrder && clTier.appendRow (qvecTimeStamps [iRow], qvecColumns, iRow);
+            }
+        }
+
+        // rows out of time order, rebuild the tiers in time order
+        if (bInOrder == false)
+        {
+            qvecRows.resize (pclCache->iNumRows);
+            for (iRow = 0; iRow < qvecRows.size (); iRow++)
+            {
+                qvecRows [iRow] = iRow;
+            }
+            std::stable_sort (qvecRows.begin (), qvecRows.end (), [&qvecTimeStamps] (const int iA, const int iB)
+            {
+                return (qvecTimeStamps [iA] < qvecTimeStamps [iB]);
+            });
+
+            for (TelemetryTier& clTier : pclCache->qvecTiers)
+            {
+                clTier.reset (1);
+                for (iRow = 0; iRow < qvecRows.size (); iRow++)
+                {
+                    clTier.appendRow (qvecTimeStamps [qvecRows [iRow]], qvecColumns, qvecRows [iRow]);
+                }
+            }
+        }
+
+        pclCache->iNumTierRows = pclCache->iNumRows;
+    }
+
+    return (pclCache->qvecTiers [qBound (0, iTier, TelemetrySeries::iNumTiers - 1)]);
+}
+
+
+QuantileSketch DerivedChannels::sketch (const TelemetrySeries& clSeries, const QString& qstrChannel, const qint64 tStart, const qint64 tStop)
+{
+    // declaration of variables
+    QuantileSketch         clSketch;
+    sChannelCache_t*       pclCache = this->update (clSeries, qstrChannel);
+    const QVector<qint64>& qvecTimeStamps = clSeries.timeStamps ();
+    qint64                 tDay;
+    int                    iRow;
+
+    if (pclCache == NULL)
+    {
+        return (clSketch);
+    }
+
+    for (iRow = pclCache->iNumSketchRows; iRow < pclCache->iNumRows; iRow++)
+    {
+        tDay = qvecTimeStamps [iRow] / TelemetrySeries::lliSketchSeconds;
+        if ((qvecTimeStamps [iRow] % TelemetrySeries::lliSketchSeconds) < 0)
+        {
+            tDay--;
+        }
+        pclCache->qmapDaySketches [tDay * TelemetrySeries::lliSketchSeconds].add (pclCache->qvecValues [iRow]);
+    }
+    pclCache->iNumSketchRows = pclCache->iNumRows;
+
+    tDay = tStart / TelemetrySeries::lliSketchSeconds;
+    if ((tStart % TelemetrySeries::lliSketchSeconds) < 0)
+    {
+        tDay--;
+    }
+
+    for (QMap<qint64, QuantileSketch>::const_iterator itDay = pclCache->qmapDaySketches.lowerBound (tDay * TelemetrySeries::lliSketchSeconds);
+         (itDay != pclCache->qmapDaySketches.constEnd ()) && (itDay.key () <= tStop); ++itDay)
+    {
+        clSketch.merge (itDay.value ());
+    }
+
+    return (clSketch);
+}
+
+
+void DerivedChannels::clearCache (void)
+{
+    this->qhashCache.clear ();
+}
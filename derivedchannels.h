@@ -0,0 +1,307 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file derivedchannels.h
+ *
+ * \brief contains the defintion of the DerivedChannels class.
+ *
+ * ---
+ */
+
+
+#ifndef DERIVEDCHANNELS_H
+#define DERIVEDCHANNELS_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QSharedPointer>
+
+#include <vector>
+
+#include "telemetrystore.h"
+
+
+#define C_DERIVED_CHANNELS_NAME "DerivedChannels"
+
+
+/**
+ * \class DerivedChannels
+ *
+ * \brief This class computes derived channels from the columns of a TelemetrySeries.
+ *
+ * A derived channel is defined by an arithmetic expression over the channels of
+ * the series, e.g. "(batt1_curr + batt2_curr) * batt_volt". Supported are
+ * numbers, channel names (also of other derived channels), + - * /, unary minus,
+ * brackets and the functions:<br>
+ *<br>
+ *abs (x)      = absolute value<br>
+ *diff (x)     = difference to the previous row<br>
+ *integral (x) = cumulative trapezoid integral of x over time in hours, logging gaps
+ *               (> C_ENERGY_MAX_GAP_SECONDS) are not integrated, like in EnergyAnalytics<br>
+ *<br>
+ * The expressions are compiled into a postfix program once. The program is
+ * evaluated on blocks of rows, every operation is a plain loop over the block,
+ * that is vectorised by the compiler. The results are cached per series and
+ * channel. If the series only got new rows, only the new rows are evaluated,
+ * the state of diff () and integral () is carried over between the blocks.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class DerivedChannels
+{
+    private:
+        /**
+         * operations of a compiled expression.
+         */
+        enum eOperation_t
+        {
+            OP_CONST    = 0,
+            OP_CHANNEL  = 1,
+            OP_ADD      = 2,
+            OP_SUB      = 3,
+            OP_MUL      = 4,
+            OP_DIV      = 5,
+            OP_NEG      = 6,
+            OP_ABS      = 7,
+            OP_DIFF     = 8,
+            OP_INTEGRAL = 9
+        };
+
+        /**
+         * one operation of a compiled expression (postfix order).
+         */
+        typedef struct
+        {
+            eOperation_t eOperation;    ///< operation
+            double       dValue;        ///< value of OP_CONST
+            QString      qstrChannel;   ///< channel name of OP_CHANNEL
+        } sOperation_t;
+
+        /**
+         * state of an operation, that is carried over between the blocks.
+         */
+        typedef struct
+        {
+            double dLastValue;          ///< last argument value (diff, integral)
+            qint64 tLastTimeStamp;      ///< timestamp of the last argument value (integral)
+            double dSum;                ///< integral value (integral)
+        } sOperationState_t;
+
+        /**
+         * cached values of a derived channel of one series.
+         */
+        typedef struct
+        {
+            quint64                        uiContentId;     ///< content id of the series
+            int                            iNumRows;        ///< number of evaluated rows
+            QVector<double>                qvecValues;      ///< values of the derived channel
+            std::vector<sOperationState_t> vecState;        ///< state of the operations
+            QVector<TelemetryTier>         qvecTiers;       ///< downsampled tiers of the values
+            int                            iNumTierRows;    ///< number of rows inside the tiers
+            QMap<qint64, QuantileSketch>   qmapDaySketches; ///< quantile sketches per day of the values
+            int                            iNumSketchRows;  ///< number of rows inside the sketches
+            bool                           bBusy;           ///< true, while the channel is evaluated (cycle detection)
+        } sChannelCache_t;
+
+        /**
+         * number of rows, that are evaluated in one block.
+         */
+        static constexpr int iBlockSize = 1024;
+
+        /**
+         * expressions and compiled programs, key is the channel name.
+         */
+        QHash<QString, QString>               qhashExpressions;
+        QHash<QString, QVector<sOperation_t> > qhashPrograms;
+
+        /**
+         * cached values, key is "component/channel".
+         */
+        QHash<QString, QSharedPointer<sChannelCache_t> > qhashCache;
+
+        /**
+         * evaluation stack, reused for all blocks.
+         */
+        std::vector<std::vector<double> > vecStack;
+
+        /**
+         * \brief Compiles an expression into a postfix program.
+         *
+         * @param[in] const QString& qstrExpression = expression
+         * @param[out] QVector<sOperation_t>& qvecProgram = compiled program
+         * @param[out] QString& qstrError = error message
+         * \return bool = true: OK / false: syntax error
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool compile (const QString& qstrExpression, QVector<sOperation_t>& qvecProgram, QString& qstrError);
+
+        /**
+         * \brief Brings the cache of a derived channel up to date and returns it.
+         *
+         * @param[in] const TelemetrySeries& clSeries = series
+         * @param[in] const QString& qstrChannel = derived channel name
+         * \return sChannelCache_t* = cache / NULL if there is no such derived channel or the definition is cyclic
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        sChannelCache_t* update (const TelemetrySeries& clSeries, const QString& qstrChannel);
+
+        /**
+         * \brief Evaluates a block of rows.
+         *
+         * @param[in] const QVector<sOperation_t>& qvecProgram = compiled program
+         * @param[in] const std::vector<const double*>& vecSources = column of each OP_CHANNEL operation, NULL = NaN
+         * @param[in] const qint64* ptTimeStamps = timestamp column of the series
+         * @param[in,out] std::vector<sOperationState_t>& vecState = state of the operations
+         * @param[in] const int iStart = first row
+         * @param[in] const int iCount = number of rows (max. iBlockSize)
+         * @param[out] double* pdResult = result values
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void evaluateBlock (const QVector<sOperation_t>& qvecProgram, const std::vector<const double*>& vecSources,
+                            const qint64* ptTimeStamps, std::vector<sOperationState_t>& vecState,
+                            const int iStart, const int iCount, double* pdResult);
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * Defines the default derived channels of the HW_STATUS component:<br>
+         *<br>
+         *power      = (batt1_curr + batt2_curr) * batt_volt [W]<br>
+         *energy     = integral (power) [Wh]<br>
+         *temp_delta = temp - temp_sensor [degree C]<br>
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        DerivedChannels (void);
+
+        /**
+         * \brief Defines or replaces a derived channel.
+         *
+         * @param[in] const QString& qstrChannel = name of the derived channel
+         * @param[in] const QString& qstrExpression = expression
+         * @param[out] QString* pqstrError = error message, may be NULL
+         * \return bool = true: OK / false: syntax error inside expression
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool define (const QString& qstrChannel, const QString& qstrExpression, QString* pqstrError = NULL);
+
+        /**
+         * \brief Checks, if a derived channel is defined.
+         *
+         * @param[in] const QString& qstrChannel = name of the derived channel
+         * \return bool = true: defined / false: not defined
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool contains (const QString& qstrChannel) const;
+
+        /**
+         * \brief Returns the names of all derived channels.
+         *
+         * \return QStringList = channel names
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QStringList names (void) const;
+
+        /**
+         * \brief Returns the values of a derived channel.
+         *
+         * The values are evaluated on first access and cached, later calls only
+         * evaluate the rows, that have been appended since.
+         *
+         * @param[in] const TelemetrySeries& clSeries = series
+         * @param[in] const QString& qstrChannel = name of the derived channel
+         * \return const QVector<double>& = values, one per row of the series / empty vector if there is no such channel
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const QVector<double>& column (const TelemetrySeries& clSeries, const QString& qstrChannel);
+
+        /**
+         * \brief Returns a downsampled tier of a derived channel.
+         *
+         * The tier contains one channel (index 0) and uses the same buckets as the
+         * tiers of the series.
+         *
+         * @param[in] const TelemetrySeries& clSeries = series
+         * @param[in] const QString& qstrChannel = name of the derived channel
+         * @param[in] const int iTier = tier index (0 = minute, 1 = hour, 2 = day)
+         * \return const TelemetryTier& = tier / empty tier if there is no such channel
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const TelemetryTier& tier (const TelemetrySeries& clSeries, const QString& qstrChannel, const int iTier);
+
+        /**
+         * \brief Returns the quantile sketch of a derived channel for a time range.
+         *
+         * Like TelemetrySeries::sketch, the channel has one sketch per day and the range
+         * is extended to full days.
+         *
+         * @param[in] const TelemetrySeries& clSeries = series
+         * @param[in] const QString& qstrChannel = name of the derived channel
+         * @param[in] const qint64 tStart = start of the range in epoch seconds
+         * @param[in] const qint64 tStop = stop of the range in epoch seconds
+         * \return QuantileSketch = merged sketch / empty sketch if there is no such channel
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QuantileSketch sketch (const TelemetrySeries& clSeries, const QString& qstrChannel, const qint64 tStart, const qint64 tStop);
+
+        /**
+         * \brief Removes all cached values.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void clearCache (void);
+};
+
+#endif // DERIVEDCHANNELS_H
@@ -0,0 +1,209 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file energyanalytics.cpp
+ *
+ * \brief contains the implementation of the EnergyAnalytics class.
+ *
+ * ---
+ */
+
+
+#include "energyanalytics.h"
+
+#include <cmath>
+
+
+EnergyAnalytics::EnergyAnalytics (const qint64 lliMaxGapSecondsValue, const double dCutOffVoltageValue,
+                                  const double dTrendTimeConstantValue)
+{
+    this->lliMaxGapSeconds   = qMax (lliMaxGapSecondsValue, (qint64) 1);
+    this->dCutOffVoltage     = dCutOffVoltageValue;
+    this->dTrendTimeConstant = qMax (dTrendTimeConstantValue, 1.0);
+
+    this->reset ();
+}
+
+
+void EnergyAnalytics::reset (void)
+{
+    this->tFirstTimeStamp   = 0;
+    this->tLastTimeStamp    = 0;
+    this->dLastPower        = 0.0;
+    this->bHaveLast         = false;
+    this->dEnergyWh         = 0.0;
+    this->lliCoveredSeconds = 0;
+    this->lliGapSeconds     = 0;
+    this->iNumGaps          = 0;
+
+    this->dTrendWeight         = 0.0;
+    this->dTrendMeanTime       = 0.0;
+    this->dTrendMeanVoltage    = 0.0;
+    this->dTrendCovTimeVoltage = 0.0;
+    this->dTrendVarTime        = 0.0;
+    this->tTrendLastTimeStamp  = 0;
+
+    this->uiContentId = 0;
+    this->iNumRows    = 0;
+}
+
+
+void EnergyAnalytics::addSample (const qint64 tTimeStamp, const double dBattVoltage, const double dBattCurr1, const double dBattCurr2)
+{
+    // declaration of variables
+    const double dPower = (dBattCurr1 + dBattCurr2) * dBattVoltage;
+    const bool   bValid = (std::isnan (dPower) == false);
+    qint64       lliDelta;
+    double       dDecay;
+    double       dTime;
+    double       dDeltaTime;
+
+    if ((this->tFirstTimeStamp != 0) && (tTimeStamp < this->tLastTimeStamp))
+    {
+        return;
+    }
+
+    if (this->tFirstTimeStamp == 0)
+    {
+        this->tFirstTimeStamp = tTimeStamp;
+    }
+    else
+    {
+        // integrate the interval to the previous sample or count it as gap
+        lliDelta = tTimeStamp - this->tLastTimeStamp;
+        if ((this->bHaveLast == true) && (EnergyAnalytics::integrate (this->dLastPower, dPower, lliDelta, this->lliMaxGapSeconds, this->dEnergyWh) == true))
+        {
+            this->lliCoveredSeconds += lliDelta;
+        }
+        else if (lliDelta > 0)
+        {
+            this->lliGapSeconds += lliDelta;
+            this->iNumGaps++;
+        }
+    }
+
+    this->tLastTimeStamp = tTimeStamp;
+    this->dLastPower     = dPower;
+    this->bHaveLast      = bValid;
+
+    // exponentially weighted linear fit of the battery voltage over time
+    if (std::isnan (dBattVoltage) == false)
+    {
+        dTime  = (double) (tTimeStamp - this->tFirstTimeStamp);
+        dDecay = 1.0;
+        if (this->dTrendWeight > 0.0)
+        {
+            dDecay = std::exp (-((double) (tTimeStamp - this->tTrendLastTimeStamp)) / this->dTrendTimeConstant);
+        }
+
+        this->dTrendWeight          = (dDecay * this->dTrendWeight) + 1.0;
+        dDeltaTime                  = dTime - this->dTrendMeanTime;
+        this->dTrendMeanTime       += dDeltaTime / this->dTrendWeight;
+        this->dTrendMeanVoltage    += (dBattVoltage - this->dTrendMeanVoltage) / this->dTrendWeight;
+        this->dTrendCovTimeVoltage  = (dDecay * this->dTrendCovTimeVoltage) + (dDeltaTime * (dBattVoltage - this->dTrendMeanVoltage));
+        this->dTrendVarTime         = (dDecay * this->dTrendVarTime)        + (dDeltaTime * (dTime        - this->dTrendMeanTime));
+        this->tTrendLastTimeStamp   = tTimeStamp;
+    }
+}
+
+
+void EnergyAnalytics::update (const TelemetrySeries& clSeries)
+{
+    // declaration of variables
+    const QVector<qint64>& qvecTimeStamps  = clSeries.timeStamps ();
+    const QVector<double>& qvecBattVoltage = clSeries.column ("batt_volt");
+    const QVector<double>& qvecBattCurr1   = clSeries.column ("batt1_curr");
+    const QVector<double>& qvecBattCurr2   = clSeries.column ("batt2_curr");
+    int                    iCounter;
+
+    if ((this->uiContentId != clSeries.contentId ()) || (this->iNumRows > clSeries.size ()))
+    {
+        this->reset ();
+        this->uiContentId = clSeries.contentId ();
+    }
+
+    if ((qvecBattVoltage.isEmpty () == true) || (qvecBattCurr1.isEmpty () == true) || (qvecBattCurr2.isEmpty () == true))
+    {
+        return;
+    }
+
+    for (iCounter = this->iNumRows; iCounter < clSeries.size (); iCounter++)
+    {
+        this->addSample (qvecTimeStamps [iCounter], qvecBattVoltage [iCounter], qvecBattCurr1 [iCounter], qvecBattCurr2 [iCounter]);
+    }
+    this->iNumRows = clSeries.size ();
+}
+
+
+sEnergySummary_t EnergyAnalytics::summary (void) const
+{
+    // declaration of variables
+    sEnergySummary_t sSummary;
+    double           dSlope = 0.0;
+    double           dTime;
+
+    sSummary.dEnergyWh         = this->dEnergyWh;
+    sSummary.lliCoveredSeconds = this->lliCoveredSeconds;
+    sSummary.lliGapSeconds     = this->lliGapSeconds;
+    sSummary.iNumGaps          = this->iNumGaps;
+    sSummary.dMeanPowerW       = 0.0;
+    sSummary.dVoltage          = this->dTrendMeanVoltage;
+    sSummary.dVoltageSlope     = 0.0;
+    sSummary.dRemainingHours   = -1.0;
+    sSummary.tEmptyTime        = 0;
+
+    if (this->lliCoveredSeconds > 0)
+    {
+        sSummary.dMeanPowerW = this->dEnergyWh / ((double) this->lliCoveredSeconds / 3600.0);
+    }
+    sSummary.dGapEnergyWh = sSummary.dMeanPowerW * ((double) this->lliGapSeconds / 3600.0);
+
+    if (this->dTrendVarTime > 0.0)
+    {
+        // trend value at the last sample, slope in V/s
+        dSlope            = this->dTrendCovTimeVoltage / this->dTrendVarTime;
+        dTime             = (double) (this->tTrendLastTimeStamp - this->tFirstTimeStamp);
+        sSummary.dVoltage = this->dTrendMeanVoltage + (dSlope * (dTime - this->dTrendMeanTime));
+
+        sSummary.dVoltageSlope = dSlope * 3600.0;
+        if ((dSlope < 0.0) && (sSummary.dVoltage > this->dCutOffVoltage))
+        {
+            sSummary.dRemainingHours = ((sSummary.dVoltage - this->dCutOffVoltage) / -dSlope) / 3600.0;
+            sSummary.tEmptyTime      = this->tTrendLastTimeStamp + (qint64) (sSummary.dRemainingHours * 3600.0);
+        }
+        else if (sSummary.dVoltage <= this->dCutOffVoltage)
+        {
+            sSummary.dRemainingHours = 0.0;
+            sSummary.tEmptyTime      = this->tTrendLastTimeStamp;
+        }
+    }
+
+    return (sSummary);
+}
@@ -0,0 +1,224 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file energyanalytics.h
+ *
+ * \brief contains the defintion of the EnergyAnalytics class.
+ *
+ * ---
+ */
+
+
+#ifndef ENERGYANALYTICS_H
+#define ENERGYANALYTICS_H
+
+#include <QtGlobal>
+
+#include <cmath>
+
+#include "telemetrystore.h"
+
+
+/**
+ * max. distance of two samples, that are integrated [s], longer intervals are logging gaps.
+ */
+#define C_ENERGY_MAX_GAP_SECONDS 900
+
+
+/**
+ * energy balance and runtime forecast of one station.
+ */
+typedef struct
+{
+    double  dEnergyWh;          ///< energy integrated over the covered time [Wh]
+    double  dGapEnergyWh;       ///< estimated energy during gaps (mean power * gap time) [Wh]
+    qint64  lliCoveredSeconds;  ///< time covered by samples [s]
+    qint64  lliGapSeconds;      ///< time inside gaps [s]
+    int     iNumGaps;           ///< number of gaps
+    double  dMeanPowerW;        ///< mean power over the covered time [W]
+    double  dVoltage;           ///< battery voltage of the discharge trend at the last sample [V]
+    double  dVoltageSlope;      ///< slope of the discharge trend [V/h]
+    double  dRemainingHours;    ///< remaining runtime until cut-off voltage [h], -1 = not discharging
+    qint64  tEmptyTime;         ///< projected time of cut-off voltage in epoch seconds, 0 = not discharging
+} sEnergySummary_t;
+
+
+/**
+ * \class EnergyAnalytics
+ *
+ * \brief Integrates the power consumption and forecasts the battery runtime.
+ *
+ * The samples are processed in streaming fashion with O(1) work and memory per
+ * sample, hence the analytics can be kept up to date in live-tail mode for many
+ * stations.<br>
+ *<br>
+ * Energy: the power (batt1_curr + batt2_curr) * batt_volt is integrated with the
+ * trapezoid rule. Intervals longer than the max. gap length or with invalid samples
+ * are not integrated, they are counted as gaps and estimated separately with the
+ * mean power.<br>
+ *<br>
+ * Runtime: the battery voltage is fitted by a linear trend with exponential
+ * forgetting (time constant, default 12 h), hence the trend follows changes of the
+ * load and charging phases. The remaining runtime is the time until the trend
+ * reaches the cut-off voltage.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class EnergyAnalytics
+{
+    private:
+        /**
+         * parameters.
+         */
+        qint64 lliMaxGapSeconds;
+        double dTrendTimeConstant;
+        double dCutOffVoltage;
+
+        /**
+         * state of the integration.
+         */
+        qint64 tFirstTimeStamp;
+        qint64 tLastTimeStamp;
+        double dLastPower;
+        bool   bHaveLast;
+        double dEnergyWh;
+        qint64 lliCoveredSeconds;
+        qint64 lliGapSeconds;
+        int    iNumGaps;
+
+        /**
+         * state of the exponentially weighted trend fit. The time is relative to the
+         * first sample to keep the numbers small.
+         */
+        double dTrendWeight;
+        double dTrendMeanTime;
+        double dTrendMeanVoltage;
+        double dTrendCovTimeVoltage;
+        double dTrendVarTime;
+        qint64 tTrendLastTimeStamp;
+
+        /**
+         * series, that is tracked by update (), and number of processed rows.
+         */
+        quint64 uiContentId;
+        int     iNumRows;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const qint64 lliMaxGapSecondsValue = max. distance of two samples, that are integrated [s]
+         * @param[in] const double dCutOffVoltageValue = battery cut-off voltage [V]
+         * @param[in] const double dTrendTimeConstantValue = time constant of the discharge trend [s]
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        EnergyAnalytics (const qint64 lliMaxGapSecondsValue = C_ENERGY_MAX_GAP_SECONDS, const double dCutOffVoltageValue = 10.5,
+                         const double dTrendTimeConstantValue = 12.0 * 3600.0);
+
+        /**
+         * \brief Integrates the interval between two samples with the trapezoid rule.
+         *
+         * Intervals with a NaN value at either end, negative intervals and intervals
+         * longer than the max. gap are not integrated.
+         *
+         * @param[in] const double dLastValue = value of the previous sample
+         * @param[in] const double dValue = value of the sample
+         * @param[in] const qint64 lliDelta = distance of the samples [s]
+         * @param[in] const qint64 lliMaxGapSeconds = max. distance of two samples, that are integrated [s]
+         * @param[in,out] double& dIntegral = integral, the interval is added to [value * h]
+         * \return bool = true: interval integrated / false: interval skipped
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool integrate (const double dLastValue, const double dValue, const qint64 lliDelta, const qint64 lliMaxGapSeconds, double& dIntegral)
+        {
+            if ((std::isnan (dLastValue) == true) || (std::isnan (dValue) == true) || (lliDelta < 0) || (lliDelta > lliMaxGapSeconds))
+            {
+                return (false);
+            }
+
+            dIntegral += 0.5 * (dLastValue + dValue) * ((double) lliDelta / 3600.0);
+
+            return (true);
+        }
+
+        /**
+         * \brief Adds one sample.
+         *
+         * The samples need to be added in time order, older samples are ignored.
+         *
+         * @param[in] const qint64 tTimeStamp = timestamp in epoch seconds
+         * @param[in] const double dBattVoltage = battery voltage [V]
+         * @param[in] const double dBattCurr1 = current battery 1 [A]
+         * @param[in] const double dBattCurr2 = current battery 2 [A]
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void addSample (const qint64 tTimeStamp, const double dBattVoltage, const double dBattCurr1, const double dBattCurr2);
+
+        /**
+         * \brief Adds the rows of a HW_STATUS series, that have not been processed yet.
+         *
+         * If the series has been cleared since the last call, the analytics are reset.
+         *
+         * @param[in] const TelemetrySeries& clSeries = HW_STATUS series
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void update (const TelemetrySeries& clSeries);
+
+        /**
+         * \brief Returns the energy balance and runtime forecast.
+         *
+         * \return sEnergySummary_t = summary
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        sEnergySummary_t summary (void) const;
+
+        /**
+         * \brief Resets all accumulated values.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void reset (void);
+};
+
+#endif // ENERGYANALYTICS_H
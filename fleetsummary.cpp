@@ -0,0 +1,278 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file fleetsummary.cpp
+ *
+ * \brief contains the implementation of the FleetSummary class.
+ *
+ * ---
+ */
+
+
+#include "fleetsummary.h"
+#include "gapdetector.h"
+#include "statusdecoder.h"
+
+#include <cmath>
+#include <limits>
+
+
+FleetSummary::FleetSummary (const int iSyncedStateValue)
+{
+    this->iSyncedState = iSyncedStateValue;
+}
+
+
+bool FleetSummary::updateHwStatus (sStationCache_t& sCache, const TelemetrySeries& clSeries)
+{
+    // declaration of variables
+    const QVector<qint64>& qvecTimeStamps = clSeries.timeStamps ();
+    const QVector<double>& qvecTemp       = clSeries.column ("temp");
+    const QVector<double>& qvecVoltage    = clSeries.column ("batt_volt");
+    QuantileSketch         clSketch;
+    double                 dValue;
+    int                    iRow;
+    bool                   bRetValue = false;
+
+    // restart, if the rows of the series have been replaced
+    if ((sCache.uiHwContentId != clSeries.contentId ()) || (sCache.iNumHwRows > clSeries.size ()))
+    {
+        sCache.uiHwContentId             = clSeries.contentId ();
+        sCache.iNumHwRows                = 0;
+        sCache.tHwLast                   = 0;
+        sCache.tLastVoltage              = 0;
+        GapDetector::detect (QVector<qint64> (), C_FLEET_GAP_FACTOR, sCache.sHwCompleteness);
+        sCache.sSummary.dBattVoltage     = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dRemainingHours  = -1.0;
+        sCache.sSummary.dMinTemp         = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dMaxTemp         = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dCompleteness    = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dBattP1          = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dBattP50         = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dBattP99         = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dTempP1          = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dTempP50         = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dTempP99         = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dPowerP1         = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dPowerP50        = std::numeric_limits<double>::quiet_NaN ();
+        sCache.sSummary.dPowerP99        = std::numeric_limits<double>::quiet_NaN ();
+        bRetValue                        = true;
+    }
+
+    if (sCache.iNumHwRows == clSeries.size ())
+    {
+        return (bRetValue);
+    }
+
+    for (iRow = sCache.iNumHwRows; iRow < clSeries.size (); iRow++)
+    {
+        if (iRow == 0)
+        {
+            sCache.tHwLast = qvecTimeStamps [iRow];
+        }
+        else
+        {
+            sCache.tHwLast = qMax (sCache.tHwLast, qvecTimeStamps [iRow]);
+        }
+
+        if (iRow < qvecTemp.size ())
+        {
+            dValue = qvecTemp [iRow];
+            if ((std::isnan (dValue) == false) &&
+                ((std::isnan (sCache.sSummary.dMinTemp) == true) || (dValue < sCache.sSummary.dMinTemp)))
+            {
+                sCache.sSummary.dMinTemp = dValue;
+            }
+            if ((std::isnan (dValue) == false) &&
+                ((std::isnan (sCache.sSummary.dMaxTemp) == true) || (dValue > sCache.sSummary.dMaxTemp)))
+            {
+                sCache.sSummary.dMaxTemp = dValue;
+            }
+        }
+
+        if ((iRow < qvecVoltage.size ()) && (std::isnan (qvecVoltage [iRow]) == false) &&
+            ((std::isnan (sCache.sSummary.dBattVoltage) == true) || (qvecTimeStamps [iRow] >= sCache.tLastVoltage)))
+        {
+            sCache.sSummary.dBattVoltage = qvecVoltage [iRow];
+            sCache.tLastVoltage          = qvecTimeStamps [iRow];
+        }
+    }
+    sCache.iNumHwRows = clSeries.size ();
+
+    // the nominal period follows the series, it is computed again whenever the series has doubled
+    if (GapDetector::append (qvecTimeStamps, C_FLEET_GAP_FACTOR, sCache.sHwCompleteness) == true)
+    {
+        sCache.sSummary.dCompleteness = sCache.sHwCompleteness.dCompleteness;
+    }
+
+    sCache.clEnergy.update (clSeries);
+    sCache.sSummary.dRemainingHours = sCache.clEnergy.summary ().dRemainingHours;
+
+    // the day sketches of the series answer the percentiles without scanning the rows
+    clSketch                 = clSeries.sketch ("batt_volt", sCache.tHwLast, sCache.tHwLast);
+    sCache.sSummary.dBattP1  = clSketch.quantile (0.01);
+    sCache.sSummary.dBattP50 = clSketch.quantile (0.50);
+    sCache.sSummary.dBattP99 = clSketch.quantile (0.99);
+    clSketch                 = clSeries.sketch ("temp", sCache.tHwLast, sCache.tHwLast);
+    sCache.sSummary.dTempP1  = clSketch.quantile (0.01);
+    sCache.sSummary.dTempP50 = clSketch.quantile (0.50);
+    sCache.sSummary.dTempP99 = clSketch.quantile (0.99);
+
+    // the power is a derived channel, its day sketches are kept by the derived channel cache
+    clSketch                  = sCache.clDerived.sketch (clSeries, "power", sCache.tHwLast, sCache.tHwLast);
+    sCache.sSummary.dPowerP1  = clSketch.quantile (0.01);
+    sCache.sSummary.dPowerP50 = clSketch.quantile (0.50);
+    sCache.sSummary.dPowerP99 = clSketch.quantile (0.99);
+
+    return (true);
+}
+
+
+bool FleetSummary::updateGpsStatus (sStationCache_t& sCache, const TelemetrySeries& clSeries) const
+{
+    // declaration of variables
+    const QVector<qint64>& qvecTimeStamps = clSeries.timeStamps ();
+    qint64                 lliSyncedSeconds = 0;
+    qint64                 lliTotalSeconds  = 0;
+    int                    iRow;
+    bool                   bRetValue = false;
+
+    if ((sCache.uiGpsContentId != clSeries.contentId ()) || (sCache.iNumGpsRows > clSeries.size ()))
+    {
+        sCache.uiGpsContentId         = clSeries.contentId ();
+        sCache.iNumGpsRows            = 0;
+        sCache.tGpsLast               = 0;
+        sCache.sSummary.dGpsSyncRatio = std::numeric_limits<double>::quiet_NaN ();
+        bRetValue                     = true;
+    }
+
+    if (sCache.iNumGpsRows == clSeries.size ())
+    {
+        return (bRetValue);
+    }
+
+    for (iRow = sCache.iNumGpsRows; iRow < clSeries.size (); iRow++)
+    {
+        sCache.tGpsLast = qMax (sCache.tGpsLast, qvecTimeStamps [iRow]);
+    }
+    sCache.iNumGpsRows = clSeries.size ();
+
+    // time weighted ratio, computed from the run length encoded sync states
+    sCache.clSyncIntervals.update (clSeries);
+    for (const sStateInterval_t& sInterval : sCache.clSyncIntervals.intervals ())
+    {
+        lliTotalSeconds += sInterval.tStop - sInterval.tStart;
+        if (sInterval.iState >= this->iSyncedState)
+        {
+            lliSyncedSeconds += sInterval.tStop - sInterval.tStart;
+        }
+    }
+
+    if (lliTotalSeconds > 0)
+    {
+        sCache.sSummary.dGpsSyncRatio = (double) lliSyncedSeconds / (double) lliTotalSeconds;
+    }
+
+    return (true);
+}
+
+
+bool FleetSummary::update (const QString& qstrStation, const TelemetryStore& clStore)
+{
+    // declaration of variables
+    bool bRetValue = false;
+
+    // content ids start at 1, hence the first update processes all rows
+    if (this->qmapStations.contains (qstrStation) == false)
+    {
+        sStationCache_t& sNewCache = this->qmapStations [qstrStation];
+
+        sNewCache.sSummary.qstrStation     = qstrStation;
+        sNewCache.sSummary.tLastSeen       = 0;
+        sNewCache.sSummary.dGpsSyncRatio   = std::numeric_limits<double>::quiet_NaN ();
+        sNewCache.uiHwContentId            = 0;
+        sNewCache.iNumHwRows               = 0;
+        sNewCache.uiGpsContentId           = 0;
+        sNewCache.iNumGpsRows              = 0;
+        sNewCache.tGpsLast                 = 0;
+        bRetValue                          = true;
+    }
+
+    sStationCache_t& sCache = this->qmapStations [qstrStation];
+
+    bRetValue = FleetSummary::updateHwStatus (sCache, clStore.series (HWStatusTable::pcComponent)) || bRetValue;
+    bRetValue = this->updateGpsStatus (sCache, clStore.series (GPStatusTable::pcComponent))        || bRetValue;
+
+    sCache.sSummary.tLastSeen = 0;
+    if (sCache.iNumHwRows > 0)
+    {
+        sCache.sSummary.tLastSeen = sCache.tHwLast;
+    }
+    if (sCache.iNumGpsRows > 0)
+    {
+        sCache.sSummary.tLastSeen = qMax (sCache.sSummary.tLastSeen, sCache.tGpsLast);
+    }
+
+    return (bRetValue);
+}
+
+
+QStringList FleetSummary::stations (void) const
+{
+    return (this->qmapStations.keys ());
+}
+
+
+bool FleetSummary::summary (const QString& qstrStation, sStationSummary_t& sSummary) const
+{
+    // declaration of variables
+    QMap<QString, sStationCache_t>::const_iterator itStation = this->qmapStations.constFind (qstrStation);
+
+    if (itStation == this->qmapStations.constEnd ())
+    {
+        return (false);
+    }
+
+    sSummary = itStation.value ().sSummary;
+
+    return (true);
+}
+
+
+void FleetSummary::remove (const QString& qstrStation)
+{
+    this->qmapStations.remove (qstrStation);
+}
+
+
+void FleetSummary::clear (void)
+{
+    this->qmapStations.clear ();
+}
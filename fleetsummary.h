@@ -0,0 +1,213 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file fleetsummary.h
+ *
+ * \brief contains the defintion of the FleetSummary class.
+ *
+ * ---
+ */
+
+
+#ifndef FLEETSUMMARY_H
+#define FLEETSUMMARY_H
+
+#include <QString>
+#include <QStringList>
+#include <QMap>
+
+#include "telemetrystore.h"
+#include "energyanalytics.h"
+#include "derivedchannels.h"
+#include "stateintervals.h"
+#include "gapdetector.h"
+
+
+/**
+ * min. length of a logging gap of the HW_STATUS series as multiple of its nominal period.
+ */
+#define C_FLEET_GAP_FACTOR 3.0
+
+
+/**
+ * summary of one station, as shown in the fleet view.
+ */
+typedef struct
+{
+    QString qstrStation;        ///< station name (IP address or MeasDoc name)
+    qint64  tLastSeen;          ///< timestamp of the latest log message in epoch seconds, 0 = no message
+    double  dBattVoltage;       ///< latest battery voltage [V], NaN = unknown
+    double  dRemainingHours;    ///< remaining runtime until cut-off voltage [h], -1 = not discharging
+    double  dMinTemp;           ///< min. system temperature [degree C], NaN = unknown
+    double  dMaxTemp;           ///< max. system temperature [degree C], NaN = unknown
+    double  dBattP1;            ///< 1 % percentile of the battery voltage on the day of the latest message [V], NaN = unknown
+    double  dBattP50;           ///< median of the battery voltage on the day of the latest message [V], NaN = unknown
+    double  dBattP99;           ///< 99 % percentile of the battery voltage on the day of the latest message [V], NaN = unknown
+    double  dTempP1;            ///< 1 % percentile of the system temperature on the day of the latest message [degree C], NaN = unknown
+    double  dTempP50;           ///< median of the system temperature on the day of the latest message [degree C], NaN = unknown
+    double  dTempP99;           ///< 99 % percentile of the system temperature on the day of the latest message [degree C], NaN = unknown
+    double  dPowerP1;           ///< 1 % percentile of the power consumption on the day of the latest message [W], NaN = unknown
+    double  dPowerP50;          ///< median of the power consumption on the day of the latest message [W], NaN = unknown
+    double  dPowerP99;          ///< 99 % percentile of the power consumption on the day of the latest message [W], NaN = unknown
+    double  dGpsSyncRatio;      ///< fraction of the GPS_STATUS time with sync (0.0 ... 1.0), NaN = unknown
+    double  dCompleteness;      ///< data completeness of the HW_STATUS series (0.0 ... 1.0), NaN = unknown
+} sStationSummary_t;
+
+
+/**
+ * \class FleetSummary
+ *
+ * \brief Keeps aggregates of many stations for the fleet view.
+ *
+ * Every station has a small cache with the aggregates of its telemetry. A poll of a
+ * station only processes the rows, that have been appended to its series since the
+ * last update (the whole series, if it has been replaced), hence the summaries of all
+ * stations are available at any time without keeping or rescanning their telemetry.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class FleetSummary
+{
+    private:
+        /**
+         * aggregates of one station.
+         */
+        typedef struct sStationCache_s
+        {
+            sStationSummary_t sSummary;             ///< current summary
+            quint64           uiHwContentId;        ///< content id of the HW_STATUS series
+            int               iNumHwRows;           ///< number of processed HW_STATUS rows
+            quint64           uiGpsContentId;       ///< content id of the GPS_STATUS series
+            int               iNumGpsRows;          ///< number of processed GPS_STATUS rows
+            qint64            tHwLast;              ///< last HW_STATUS timestamp
+            qint64            tGpsLast;             ///< last GPS_STATUS timestamp
+            qint64            tLastVoltage;         ///< timestamp of the latest battery voltage
+            sCompletenessReport_t sHwCompleteness;  ///< gaps and completeness of the HW_STATUS series
+            EnergyAnalytics   clEnergy;             ///< energy balance and runtime forecast
+            DerivedChannels   clDerived;            ///< derived channels (power) of the HW_STATUS series
+            StateIntervals    clSyncIntervals;      ///< GPS sync state intervals
+
+            sStationCache_s (void) : clSyncIntervals ("sync_state") {}
+        } sStationCache_t;
+
+        /**
+         * caches of all stations, key is the station name.
+         */
+        QMap<QString, sStationCache_t> qmapStations;
+
+        /**
+         * min. value of the sync_state channel, that means "synced".
+         */
+        int iSyncedState;
+
+        /**
+         * \brief Processes the new rows of the HW_STATUS series.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool updateHwStatus (sStationCache_t& sCache, const TelemetrySeries& clSeries);
+
+        /**
+         * \brief Processes the new rows of the GPS_STATUS series.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool updateGpsStatus (sStationCache_t& sCache, const TelemetrySeries& clSeries) const;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const int iSyncedStateValue = min. value of sync_state, that means "synced"
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        FleetSummary (const int iSyncedStateValue = 1);
+
+        /**
+         * \brief Updates the aggregates of a station with its current telemetry.
+         *
+         * @param[in] const QString& qstrStation = station name
+         * @param[in] const TelemetryStore& clStore = telemetry of the station
+         * \return bool = true: summary has changed / false: no new rows
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool update (const QString& qstrStation, const TelemetryStore& clStore);
+
+        /**
+         * \brief Returns the names of all stations.
+         *
+         * \return QStringList = station names in alphabetical order
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QStringList stations (void) const;
+
+        /**
+         * \brief Returns the summary of a station.
+         *
+         * @param[in] const QString& qstrStation = station name
+         * @param[out] sStationSummary_t& sSummary = summary
+         * \return bool = true: OK / false: unknown station
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool summary (const QString& qstrStation, sStationSummary_t& sSummary) const;
+
+        /**
+         * \brief Removes a station.
+         *
+         * @param[in] const QString& qstrStation = station name
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void remove (const QString& qstrStation);
+
+        /**
+         * \brief Removes all stations.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void clear (void);
+};
+
+#endif // FLEETSUMMARY_H
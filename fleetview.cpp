@@ -0,0 +1,173 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file fleetview.cpp
+ *
+ * \brief contains the implementation of the FleetView class.
+ *
+ * ---
+ */
+
+
+#include "fleetview.h"
+
+#include <QVBoxLayout>
+#include <QHeaderView>
+#include <QDateTime>
+
+#include <cmath>
+
+
+/**
+ * columns of the fleet table.
+ */
+enum
+{
+    C_FLEET_COL_STATION = 0,
+    C_FLEET_COL_LAST_SEEN,
+    C_FLEET_COL_BATT_VOLTAGE,
+    C_FLEET_COL_RUNTIME,
+    C_FLEET_COL_MIN_TEMP,
+    C_FLEET_COL_MAX_TEMP,
+    C_FLEET_COL_BATT_PERCENTILES,
+    C_FLEET_COL_TEMP_PERCENTILES,
+    C_FLEET_COL_POWER_PERCENTILES,
+    C_FLEET_COL_GPS_SYNC,
+    C_FLEET_COL_COMPLETENESS,
+    C_FLEET_NUM_COLUMNS
+};
+
+
+/**
+ * \brief formats a value with a number of digits, "-" for unknown (NaN) values.
+ */
+static QString formatValue (const double dValue, const int iDigits)
+{
+    if (std::isnan (dValue) == true)
+    {
+        return (QStringLiteral ("-"));
+    }
+
+    return (QString::number (dValue, 'f', iDigits));
+}
+
+
+FleetView::FleetView (QWidget* pclParent) :
+    QDialog (pclParent)
+{
+    // declaration of variables
+    QVBoxLayout* pclLayout = new QVBoxLayout (this);
+
+    this->setWindowTitle ("Fleet View");
+    this->resize (1400, 400);
+
+    this->pclTable = new QTableWidget (0, C_FLEET_NUM_COLUMNS, this);
+    this->pclTable->setHorizontalHeaderLabels (QStringList () << "Station"
+                                                              << "Last Seen (UTC)"
+                                                              << "Battery [V]"
+                                                              << "Runtime [h]"
+                                                              << "Min. Temp. [degree C]"
+                                                              << "Max. Temp. [degree C]"
+                                                              << "Battery P1 / P50 / P99 [V]"
+                                                              << "Temp. P1 / P50 / P99 [degree C]"
+                                                              << "Power P1 / P50 / P99 [W]"
+                                                              << "GPS Sync [%]"
+                                                              << "Completeness [%]");
+    this->pclTable->setEditTriggers (QAbstractItemView::NoEditTriggers);
+    this->pclTable->setSelectionBehavior (QAbstractItemView::SelectRows);
+    this->pclTable->horizontalHeader ()->setSectionResizeMode (QHeaderView::ResizeToContents);
+    this->pclTable->verticalHeader   ()->setVisible (false);
+
+    pclLayout->addWidget (this->pclTable);
+}
+
+
+void FleetView::setCell (const int iRow, const int iColumn, const QString& qstrText)
+{
+    // declaration of variables
+    QTableWidgetItem* pclItem = this->pclTable->item (iRow, iColumn);
+
+    if (pclItem == NULL)
+    {
+        pclItem = new QTableWidgetItem ();
+        this->pclTable->setItem (iRow, iColumn, pclItem);
+    }
+
+    pclItem->setText (qstrText);
+}
+
+
+void FleetView::showFleet (const FleetSummary& clFleet)
+{
+    // declaration of variables
+    sStationSummary_t sSummary;
+
+    this->pclTable->setRowCount (0);
+    this->qhashRows.clear ();
+
+    for (const QString& qstrStation : clFleet.stations ())
+    {
+        if (clFleet.summary (qstrStation, sSummary) == true)
+        {
+            this->updateStation (sSummary);
+        }
+    }
+}
+
+
+void FleetView::updateStation (const sStationSummary_t& sSummary)
+{
+    // declaration of variables
+    int iRow = this->qhashRows.value (sSummary.qstrStation, -1);
+
+    if (iRow < 0)
+    {
+        iRow = this->pclTable->rowCount ();
+        this->pclTable->insertRow (iRow);
+        this->qhashRows.insert (sSummary.qstrStation, iRow);
+    }
+
+    this->setCell (iRow, C_FLEET_COL_STATION, sSummary.qstrStation);
+    this->setCell (iRow, C_FLEET_COL_LAST_SEEN, (sSummary.tLastSeen > 0) ?
+                   QDateTime::fromSecsSinceEpoch (sSummary.tLastSeen, Qt::UTC).toString ("yyyy-MM-dd hh:mm:ss") : QStringLiteral ("-"));
+    this->setCell (iRow, C_FLEET_COL_BATT_VOLTAGE, formatValue (sSummary.dBattVoltage, 2));
+    this->setCell (iRow, C_FLEET_COL_RUNTIME,      (sSummary.dRemainingHours >= 0.0) ?
+                   formatValue (sSummary.dRemainingHours, 1) : QStringLiteral ("-"));
+    this->setCell (iRow, C_FLEET_COL_MIN_TEMP,     formatValue (sSummary.dMinTemp, 1));
+    this->setCell (iRow, C_FLEET_COL_MAX_TEMP,     formatValue (sSummary.dMaxTemp, 1));
+    this->setCell (iRow, C_FLEET_COL_BATT_PERCENTILES, formatValue (sSummary.dBattP1, 2) + " / " + formatValue (sSummary.dBattP50, 2) +
+                   " / " + formatValue (sSummary.dBattP99, 2));
+    this->setCell (iRow, C_FLEET_COL_TEMP_PERCENTILES, formatValue (sSummary.dTempP1, 1) + " / " + formatValue (sSummary.dTempP50, 1) +
+                   " / " + formatValue (sSummary.dTempP99, 1));
+    this->setCell (iRow, C_FLEET_COL_POWER_PERCENTILES, formatValue (sSummary.dPowerP1, 1) + " / " + formatValue (sSummary.dPowerP50, 1) +
+                   " / " + formatValue (sSummary.dPowerP99, 1));
+    this->setCell (iRow, C_FLEET_COL_GPS_SYNC,     formatValue (sSummary.dGpsSyncRatio * 100.0, 1));
+    this->setCell (iRow, C_FLEET_COL_COMPLETENESS, formatValue (sSummary.dCompleteness * 100.0, 1));
+}
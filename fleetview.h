@@ -0,0 +1,113 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file fleetview.h
+ *
+ * \brief contains the defintion of the FleetView class.
+ *
+ * ---
+ */
+
+
+#ifndef FLEETVIEW_H
+#define FLEETVIEW_H
+
+#include <QDialog>
+#include <QTableWidget>
+#include <QHash>
+
+#include "fleetsummary.h"
+
+
+/**
+ * \class FleetView
+ *
+ * \brief Dialog with a table, one row per station.
+ *
+ * The dialog only shows the summaries of the FleetSummary class, hence opening it
+ * does not touch any telemetry. Polled stations are refreshed row by row.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class FleetView : public QDialog
+{
+    Q_OBJECT
+
+    private:
+        /**
+         * table widget and row of each station.
+         */
+        QTableWidget*       pclTable;
+        QHash<QString, int> qhashRows;
+
+        /**
+         * \brief Sets the text of a cell.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void setCell (const int iRow, const int iColumn, const QString& qstrText);
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] QWidget* pclParent = parent widget
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        explicit FleetView (QWidget* pclParent = 0);
+
+        /**
+         * \brief Shows the summaries of all stations.
+         *
+         * @param[in] const FleetSummary& clFleet = fleet aggregates
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void showFleet (const FleetSummary& clFleet);
+
+        /**
+         * \brief Updates the row of one station, the row is added if it does not exist yet.
+         *
+         * @param[in] const sStationSummary_t& sSummary = summary of the station
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void updateStation (const sStationSummary_t& sSummary);
+};
+
+#endif // FLEETVIEW_H
@@ -0,0 +1,251 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file gapdetector.cpp
+ *
+ * \brief contains the implementation of the GapDetector class.
+ *
+ * ---
+ */
+
+
+#include "gapdetector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+qint64 GapDetector::nominalPeriod (const qint64* ptTimeStamps, const int iSize)
+{
+    // declaration of variables
+    std::vector<qint64> vecDeltas;
+    int                 iCounter;
+
+    if (iSize < 2)
+    {
+        return (0);
+    }
+
+    vecDeltas.reserve (iSize - 1);
+    for (iCounter = 1; iCounter < iSize; iCounter++)
+    {
+        if (ptTimeStamps [iCounter] > ptTimeStamps [iCounter - 1])
+        {
+            vecDeltas.push_back (ptTimeStamps [iCounter] - ptTimeStamps [iCounter - 1]);
+        }
+    }
+
+    if (vecDeltas.empty () == true)
+    {
+        return (0);
+    }
+
+    std::nth_element (vecDeltas.begin (), vecDeltas.begin () + (vecDeltas.size () / 2), vecDeltas.end ());
+
+    return (vecDeltas [vecDeltas.size () / 2]);
+}
+
+
+bool GapDetector::detect (const QVector<qint64>& qvecTimeStamps, const double dGapFactor, sCompletenessReport_t& sReport)
+{
+    // declaration of variables
+    const int       iBlockSize = 4096;
+    QVector<qint64> qvecSorted;
+    const qint64*   ptTimeStamps = qvecTimeStamps.constData ();
+    int             iSize        = qvecTimeStamps.size ();
+    int             iStart;
+    int             iStop;
+    int             iCounter;
+    int             iNumGaps;
+    sLogGap_t       sGap;
+
+    sReport.iNumRows         = iSize;
+    sReport.tFirst           = 0;
+    sReport.tLast            = 0;
+    sReport.lliNominalPeriod = 0;
+    sReport.lliGapThreshold  = 0;
+    sReport.iExpectedRows    = iSize;
+    sReport.dCompleteness    = (iSize > 0) ? 1.0 : 0.0;
+    sReport.lliGapSeconds    = 0;
+    sReport.iPeriodRows      = iSize;
+    sReport.qvecGaps.clear ();
+
+    if (iSize < 2)
+    {
+        return (false);
+    }
+
+    if (std::is_sorted (qvecTimeStamps.constBegin (), qvecTimeStamps.constEnd ()) == false)
+    {
+        qvecSorted = qvecTimeStamps;
+        std::sort (qvecSorted.begin (), qvecSorted.end ());
+        ptTimeStamps = qvecSorted.constData ();
+    }
+
+    sReport.tFirst           = ptTimeStamps [0];
+    sReport.tLast            = ptTimeStamps [iSize - 1];
+    sReport.lliNominalPeriod = GapDetector::nominalPeriod (ptTimeStamps, iSize);
+    if (sReport.lliNominalPeriod <= 0)
+    {
+        return (false);
+    }
+    sReport.lliGapThreshold = (qint64) std::ceil (dGapFactor * (double) sReport.lliNominalPeriod);
+
+    // delta i is the distance between row i and row i + 1
+    for (iStart = 0; iStart < (iSize - 1); iStart += iBlockSize)
+    {
+        iStop    = qMin (iStart + iBlockSize, iSize - 1);
+        iNumGaps = 0;
+        for (iCounter = iStart; iCounter < iStop; iCounter++)
+        {
+            iNumGaps += ((ptTimeStamps [iCounter + 1] - ptTimeStamps [iCounter]) > sReport.lliGapThreshold) ? 1 : 0;
+        }
+
+        // gaps are rare, only scan the blocks, that contain some
+        for (iCounter = iStart; (iCounter < iStop) && (iNumGaps > 0); iCounter++)
+        {
+            if ((ptTimeStamps [iCounter + 1] - ptTimeStamps [iCounter]) > sReport.lliGapThreshold)
+            {
+                sGap.tStart = ptTimeStamps [iCounter];
+                sGap.tStop  = ptTimeStamps [iCounter + 1];
+                sReport.qvecGaps.push_back (sGap);
+                sReport.lliGapSeconds += sGap.tStop - sGap.tStart;
+                iNumGaps--;
+            }
+        }
+    }
+
+    sReport.iExpectedRows = (int) ((sReport.tLast - sReport.tFirst) / sReport.lliNominalPeriod) + 1;
+    sReport.dCompleteness = qMin (1.0, (double) iSize / (double) sReport.iExpectedRows);
+
+    return (true);
+}
+
+
+bool GapDetector::append (const QVector<qint64>& qvecTimeStamps, const double dGapFactor, sCompletenessReport_t& sReport)
+{
+    // declaration of variables
+    const qint64* ptTimeStamps = qvecTimeStamps.constData ();
+    int           iSize        = qvecTimeStamps.size ();
+    int           iFirstRow    = sReport.iNumRows;
+    int           iCounter;
+    qint64        tPrevious;
+    sLogGap_t     sGap;
+
+    if ((sReport.lliNominalPeriod <= 0) || (iFirstRow < 2) || (iFirstRow > iSize) || (iSize >= (2 * sReport.iPeriodRows)))
+    {
+        return (GapDetector::detect (qvecTimeStamps, dGapFactor, sReport));
+    }
+
+    if (iFirstRow == iSize)
+    {
+        return (true);
+    }
+
+    // the reported rows may have been sorted, the new ones need to follow them
+    if ((ptTimeStamps [iFirstRow] < sReport.tLast) || (std::is_sorted (ptTimeStamps + iFirstRow, ptTimeStamps + iSize) == false))
+    {
+        return (GapDetector::detect (qvecTimeStamps, dGapFactor, sReport));
+    }
+
+    tPrevious = sReport.tLast;
+    for (iCounter = iFirstRow; iCounter < iSize; iCounter++)
+    {
+        if ((ptTimeStamps [iCounter] - tPrevious) > sReport.lliGapThreshold)
+        {
+            sGap.tStart = tPrevious;
+            sGap.tStop  = ptTimeStamps [iCounter];
+            sReport.qvecGaps.push_back (sGap);
+            sReport.lliGapSeconds += sGap.tStop - sGap.tStart;
+        }
+        tPrevious = ptTimeStamps [iCounter];
+    }
+
+    sReport.iNumRows      = iSize;
+    sReport.tLast         = ptTimeStamps [iSize - 1];
+    sReport.iExpectedRows = (int) ((sReport.tLast - sReport.tFirst) / sReport.lliNominalPeriod) + 1;
+    sReport.dCompleteness = qMin (1.0, (double) iSize / (double) sReport.iExpectedRows);
+
+    return (true);
+}
+
+
+QVector<int> GapDetector::findBreaks (const QVector<double>& qvecXAxis, const double dMaxDelta)
+{
+    // declaration of variables
+    QVector<int> qvecBreaks;
+    int          iCounter;
+
+    for (iCounter = 0; iCounter < (qvecXAxis.size () - 1); iCounter++)
+    {
+        if ((qvecXAxis [iCounter + 1] - qvecXAxis [iCounter]) > dMaxDelta)
+        {
+            qvecBreaks.push_back (iCounter);
+        }
+    }
+
+    return (qvecBreaks);
+}
+
+
+void GapDetector::insertBreaks (QVector<double>& qvecValues, const QVector<int>& qvecBreaks, const bool bXAxis)
+{
+    // declaration of variables
+    QVector<double> qvecResult;
+    int             iCounter;
+    int             iBreak = 0;
+
+    if ((qvecBreaks.isEmpty () == true) || (qvecValues.isEmpty () == true))
+    {
+        return;
+    }
+
+    qvecResult.reserve (qvecValues.size () + qvecBreaks.size ());
+    for (iCounter = 0; iCounter < qvecValues.size (); iCounter++)
+    {
+        qvecResult.push_back (qvecValues [iCounter]);
+        if ((iBreak < qvecBreaks.size ()) && (qvecBreaks [iBreak] == iCounter) && ((iCounter + 1) < qvecValues.size ()))
+        {
+            if (bXAxis == true)
+            {
+                qvecResult.push_back (0.5 * (qvecValues [iCounter] + qvecValues [iCounter + 1]));
+            }
+            else
+            {
+                qvecResult.push_back (std::numeric_limits<double>::quiet_NaN ());
+            }
+            iBreak++;
+        }
+    }
+
+    qvecValues = qvecResult;
+}
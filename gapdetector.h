@@ -0,0 +1,169 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file gapdetector.h
+ *
+ * \brief contains the defintion of the GapDetector class.
+ *
+ * ---
+ */
+
+
+#ifndef GAPDETECTOR_H
+#define GAPDETECTOR_H
+
+#include <QVector>
+
+#include "telemetrystore.h"
+
+
+/**
+ * logging gap, the interval between two consecutive rows, that is too long.
+ */
+typedef struct
+{
+    qint64 tStart;      ///< timestamp of the last row before the gap
+    qint64 tStop;       ///< timestamp of the first row after the gap
+} sLogGap_t;
+
+
+/**
+ * data completeness of a series.
+ */
+typedef struct
+{
+    int               iNumRows;           ///< number of rows
+    qint64            tFirst;             ///< timestamp of the first row
+    qint64            tLast;              ///< timestamp of the last row
+    qint64            lliNominalPeriod;   ///< nominal logging period (median distance of the rows) [s]
+    qint64            lliGapThreshold;    ///< min. length of a gap [s]
+    int               iExpectedRows;      ///< number of rows for the complete time span
+    double            dCompleteness;      ///< number of rows / expected number of rows (0.0 ... 1.0)
+    qint64            lliGapSeconds;      ///< total length of all gaps [s]
+    QVector<sLogGap_t> qvecGaps;          ///< gaps in time order
+    int               iPeriodRows;        ///< number of rows, the nominal period was computed of
+} sCompletenessReport_t;
+
+
+/**
+ * \class GapDetector
+ *
+ * \brief Finds the logging gaps of a series and computes its data completeness.
+ *
+ * The nominal logging period is the median distance of consecutive rows, computed
+ * with std::nth_element in linear time. A gap is a distance longer than N times
+ * the nominal period. The gaps are found in a single pass over the timestamp
+ * column: every block of rows is counted with a branch free, vectorised loop and
+ * only blocks, that contain gaps, are scanned for their positions. Rows, that are
+ * appended to a series while it is loaded, are added to its report without another
+ * pass over the column.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class GapDetector
+{
+    public:
+        /**
+         * \brief Computes the nominal logging period.
+         *
+         * @param[in] const qint64* ptTimeStamps = timestamps in time order
+         * @param[in] const int iSize = number of timestamps
+         * \return qint64 = median distance of consecutive timestamps / 0 if there are less than 2 distinct timestamps
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static qint64 nominalPeriod (const qint64* ptTimeStamps, const int iSize);
+
+        /**
+         * \brief Finds the logging gaps and computes the completeness of a series.
+         *
+         * The timestamps are sorted first, if the rows have not been appended in
+         * time order.
+         *
+         * @param[in] const QVector<qint64>& qvecTimeStamps = timestamp column
+         * @param[in] const double dGapFactor = min. length of a gap as multiple of the nominal period
+         * @param[out] sCompletenessReport_t& sReport = gaps and completeness
+         * \return bool = true: OK / false: less than 2 rows or no nominal period
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool detect (const QVector<qint64>& qvecTimeStamps, const double dGapFactor, sCompletenessReport_t& sReport);
+
+        /**
+         * \brief Adds the rows, that have been appended since a report was computed.
+         *
+         * Only the new rows are checked for gaps, the nominal period and the gap
+         * threshold of the report are kept. The report is computed again with detect (),
+         * if the new rows are not in time order after the reported rows or if the series
+         * has doubled since its nominal period was computed, hence the period follows
+         * the series at linear total cost.
+         *
+         * @param[in] const QVector<qint64>& qvecTimeStamps = timestamp column, the report was computed of, with appended rows
+         * @param[in] const double dGapFactor = min. length of a gap as multiple of the nominal period
+         * @param[in,out] sCompletenessReport_t& sReport = gaps and completeness
+         * \return bool = true: OK / false: less than 2 rows or no nominal period
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool append (const QVector<qint64>& qvecTimeStamps, const double dGapFactor, sCompletenessReport_t& sReport);
+
+        /**
+         * \brief Finds the positions, where a line plot needs to be interrupted.
+         *
+         * @param[in] const QVector<double>& qvecXAxis = x values in ascending order
+         * @param[in] const double dMaxDelta = max. distance of two points, that are connected
+         * \return QVector<int> = indices i, where x [i + 1] - x [i] > max. distance
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static QVector<int> findBreaks (const QVector<double>& qvecXAxis, const double dMaxDelta);
+
+        /**
+         * \brief Inserts a point after each break position.
+         *
+         * For the x values the point is placed in the middle of the break, all other
+         * values get NaN, hence QCPGraph interrupts its line there.
+         *
+         * @param[in,out] QVector<double>& qvecValues = values
+         * @param[in] const QVector<int>& qvecBreaks = break positions from findBreaks ()
+         * @param[in] const bool bXAxis = true: x values / false: y values
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static void insertBreaks (QVector<double>& qvecValues, const QVector<int>& qvecBreaks, const bool bXAxis);
+};
+
+#endif // GAPDETECTOR_H
@@ -0,0 +1,660 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file ingestpipeline.cpp
+ *
+ * \brief contains the implementation of the IngestPipeline class.
+ *
+ * ---
+ */
+
+
+#include "ingestpipeline.h"
+#include "xmlparses.h"
+
+#include <QFileInfo>
+#include <QSet>
+#include <QMap>
+#include <QThread>
+#include <QVariant>
+#include <QSqlError>
+
+
+/**
+ * queries of the log messages of a station. The probe only checks, if a database contains
+ * messages, the page query fetches the messages in time order, beginning at a timestamp.
+ */
+#define C_INGEST_LOG_PROBE_QUERY "select 1 from log where component in (%1) limit 1;"
+#define C_INGEST_LOG_PAGE_QUERY  "select cast(timestamp as char), component, message from log where component in (%1)%2 order by timestamp asc%3;"
+#define C_INGEST_LOG_PAGE_SIZE   5000
+
+/**
+ * number of messages per batch, number of queued batches between fetch and decode
+ * (per decoder thread) and number of ordered batches, that wait for the GUI thread.
+ */
+#define C_INGEST_BATCH_SIZE      256
+#define C_INGEST_RAW_BATCHES     4
+#define C_INGEST_ORDERED_BATCHES 256
+
+
+MessageSource::~MessageSource (void)
+{
+}
+
+
+DBMessageSource::DBMessageSource (const QString& qstrHostRef)
+{
+    this->qstrHost          = qstrHostRef;
+    this->pclDB             = NULL;
+    this->iPageRow          = 0;
+    this->bPageKeyInclusive = true;
+    this->bLastPage         = false;
+}
+
+
+DBMessageSource::~DBMessageSource (void)
+{
+    this->close ();
+}
+
+
+/**
+ * \brief Returns the components, that are decoded, as SQL list.
+ *
+ * \return QString = list of quoted component names
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+static QString getLogComponents (void)
+{
+    return (QString ("'%1', '%2'").arg (QString::fromLatin1 (HWStatusTable::pcComponent)).arg (QString::fromLatin1 (GPStatusTable::pcComponent)));
+}
+
+
+bool DBMessageSource::open (void)
+{
+    // declaration of variables
+    QString qstrProbe = QString (C_INGEST_LOG_PROBE_QUERY).arg (getLogComponents ());
+
+    this->qvecPage.clear ();
+    this->iPageRow          = 0;
+    this->qstrPageKey       = QString ();
+    this->bPageKeyInclusive = true;
+    this->bLastPage         = false;
+
+    // the connection names differ from the ones of the GUI thread
+    this->pclDB = new DBInterface ("aduuser", "neptun", "mcpdb", this->qstrHost, 3306, "mcpdb_ingest");
+    if (this->pclDB->execQuery (qstrProbe).size () <= 0)
+    {
+        this->close ();
+        this->pclDB = new DBInterface ("aduuser", "neptun", "mcpdb07", this->qstrHost, 3306, "mcpdb07_ingest");
+    }
+
+    if (this->pclDB->execQuery (qstrProbe).size () <= 0)
+    {
+        this->qstrError = QString ("no log messages found in the database of %1").arg (this->qstrHost);
+        this->close ();
+        return (false);
+    }
+
+    return (true);
+}
+
+
+bool DBMessageSource::next (sRawMessage_t& sMessage)
+{
+    PhaseTimer clTimer ("db_fetch_row");
+
+    if ((this->iPageRow >= this->qvecPage.size ()) && (this->fetchPage () == false))
+    {
+        return (false);
+    }
+
+    sMessage = this->qvecPage [this->iPageRow];
+    this->iPageRow++;
+
+    return (true);
+}
+
+
+bool DBMessageSource::queryPage (const QString& qstrCondition, const bool bLimit, QVector<QString>& qvecKeys)
+{
+    // declaration of variables
+    QSqlQuery     clQuery;
+    sRawMessage_t sMessage;
+
+    clQuery = this->pclDB->execQuery (QString (C_INGEST_LOG_PAGE_QUERY)
+                                      .arg (getLogComponents ())
+                                      .arg (qstrCondition)
+                                      .arg ((bLimit == true) ? QString (" limit %1").arg (C_INGEST_LOG_PAGE_SIZE) : QString ()));
+
+    if (clQuery.lastError ().isValid () == true)
+    {
+        this->qstrError = QString ("unable to read the log messages of %1: %2").arg (this->qstrHost).arg (clQuery.lastError ().text ());
+        return (false);
+    }
+
+    while (clQuery.next () == true)
+    {
+        sMessage.qstrComponent = clQuery.value (1).toString ();
+        sMessage.qstrMessage   = clQuery.value (2).toString ();
+        qvecKeys.push_back (clQuery.value (0).toString ());
+        this->qvecPage.push_back (sMessage);
+    }
+
+    return (true);
+}
+
+
+bool DBMessageSource::fetchPage (void)
+{
+    // declaration of variables
+    QVector<QString> qvecKeys;
+    QString          qstrCondition;
+    int              iNumRows;
+
+    this->qvecPage.clear ();
+    this->iPageRow = 0;
+
+    if ((this->pclDB == NULL) || (this->bLastPage == true))
+    {
+        return (false);
+    }
+
+    if (this->qstrPageKey.isEmpty () == false)
+    {
+        qstrCondition = QString (" and timestamp %1 '%2'").arg ((this->bPageKeyInclusive == true) ? ">=" : ">").arg (this->qstrPageKey);
+    }
+
+    if (this->queryPage (qstrCondition, true, qvecKeys) == false)
+    {
+        this->bLastPage = true;
+        return (false);
+    }
+
+    // a short page is the last one. a full page may end within the messages of one timestamp, that has no
+    // defined order, hence these messages are left for the next page, that starts at this timestamp
+    if (qvecKeys.size () < C_INGEST_LOG_PAGE_SIZE)
+    {
+        this->bLastPage = true;
+        return (this->qvecPage.isEmpty () == false);
+    }
+
+    this->qstrPageKey       = qvecKeys.last ();
+    this->bPageKeyInclusive = true;
+
+    iNumRows = qvecKeys.size ();
+    while ((iNumRows > 0) && (qvecKeys [iNumRows - 1] == this->qstrPageKey))
+    {
+        iNumRows--;
+    }
+
+    if (iNumRows > 0)
+    {
+        this->qvecPage.resize (iNumRows);
+        return (true);
+    }
+
+    // the messages of a timestamp, that fill a complete page, are read at once
+    this->qvecPage.clear ();
+    qvecKeys.clear ();
+    this->bPageKeyInclusive = false;
+    if (this->queryPage (QString (" and timestamp = '%1'").arg (this->qstrPageKey), false, qvecKeys) == false)
+    {
+        this->bLastPage = true;
+        return (false);
+    }
+
+    return (this->qvecPage.isEmpty () == false);
+}
+
+
+void DBMessageSource::close (void)
+{
+    // a query is only kept during its page, hence the connection can be removed
+    delete (this->pclDB);
+    this->pclDB = NULL;
+    this->qvecPage.clear ();
+    this->iPageRow = 0;
+}
+
+
+QString DBMessageSource::errorString (void) const
+{
+    return (this->qstrError);
+}
+
+
+QString DBMessageSource::stationName (void) const
+{
+    return (this->qstrHost);
+}
+
+
+DumpMessageSource::DumpMessageSource (const QString& qstrFileNameRef)
+{
+    this->qstrFileName = qstrFileNameRef;
+    this->qstrHost     = QString ();
+    this->pclDevice    = NULL;
+    this->pclReader    = NULL;
+}
+
+
+DumpMessageSource::~DumpMessageSource (void)
+{
+    this->close ();
+}
+
+
+bool DumpMessageSource::open (void)
+{
+    this->pclDevice = new DecompressingDevice (this->qstrFileName);
+    if (this->pclDevice->open (QIODevice::ReadOnly) == false)
+    {
+        this->qstrError = this->pclDevice->errorString ();
+        this->close ();
+        return (false);
+    }
+
+    this->pclReader = new SqlDumpReader (this->pclDevice);
+
+    return (true);
+}
+
+
+bool DumpMessageSource::next (sRawMessage_t& sMessage)
+{
+    PhaseTimer clTimer ("dump_read_row");
+
+    if ((this->pclReader == NULL) || (this->pclReader->nextRow (this->sRow) == false))
+    {
+        return (false);
+    }
+
+    sMessage.qstrComponent = QString::fromUtf8 (this->sRow.qbaComponent);
+    sMessage.qstrMessage   = QString::fromUtf8 (this->sRow.qbaMessage);
+
+    return (true);
+}
+
+
+void DumpMessageSource::close (void)
+{
+    // the results of the reader are kept for errorString () and stationName ()
+    if (this->pclReader != NULL)
+    {
+        if (this->qstrError.isEmpty () == true)
+        {
+            this->qstrError = this->pclReader->errorString ();
+        }
+        this->qstrHost = this->pclReader->host ();
+    }
+
+    delete (this->pclReader);
+    delete (this->pclDevice);
+    this->pclReader = NULL;
+    this->pclDevice = NULL;
+}
+
+
+QString DumpMessageSource::errorString (void) const
+{
+    if ((this->qstrError.isEmpty () == true) && (this->pclReader != NULL))
+    {
+        return (this->pclReader->errorString ());
+    }
+
+    return (this->qstrError);
+}
+
+
+QString DumpMessageSource::stationName (void) const
+{
+    // declaration of variables
+    QString qstrDumpHost = (this->pclReader != NULL) ? this->pclReader->host () : this->qstrHost;
+    QString qstrLower    = qstrDumpHost.toLower ();
+
+    // the dump header contains the address of the station, like the database connection, unless the dump
+    // was created on the station itself, then the file name is the only hint
+    if ((qstrLower.isEmpty () == true) || (qstrLower == "localhost") ||
+        (qstrLower == "127.0.0.1")     || (qstrLower == "::1"))
+    {
+        return (QFileInfo (this->qstrFileName).baseName ());
+    }
+
+    return (qstrDumpHost);
+}
+
+
+IngestPipeline::IngestPipeline (MessageSource* pclSourceRef, const qint64 tStartValue, const qint64 tStopValue, QObject* pclParent) :
+    QObject          (pclParent),
+    clRawQueue       (C_INGEST_RAW_BATCHES * qMax (QThread::idealThreadCount (), 1)),
+    clDecodedQueue   (C_INGEST_RAW_BATCHES * qMax (QThread::idealThreadCount (), 1)),
+    clOrderedQueue   (C_INGEST_ORDERED_BATCHES),
+    iRunningDecoders (0),
+    bNotified        (false),
+    bAbort           (false),
+    bFinished        (false)
+{
+    this->pclSource = pclSourceRef;
+    this->tStart    = tStartValue;
+    this->tStop     = tStopValue;
+
+    this->sStats.iNumRecords    = 0;
+    this->sStats.iNumDuplicates = 0;
+    this->sStats.iNumOutOfOrder = 0;
+}
+
+
+IngestPipeline::~IngestPipeline (void)
+{
+    this->abort ();
+    delete (this->pclSource);
+}
+
+
+bool IngestPipeline::start (void)
+{
+    // declaration of variables
+    int iCounter;
+    int iNumDecoders;
+
+    if ((this->clFetchThread.joinable () == true) || (this->pclSource == NULL))
+    {
+        return (false);
+    }
+
+    // fetch and order stage need a core as well
+    iNumDecoders           = qMax (QThread::idealThreadCount () - 2, 1);
+    this->iRunningDecoders = iNumDecoders;
+
+    this->clFetchThread = std::thread (&IngestPipeline::fetch, this);
+    for (iCounter = 0; iCounter < iNumDecoders; iCounter++)
+    {
+        this->vecDecodeThreads.push_back (std::thread (&IngestPipeline::decode, this));
+    }
+    this->clOrderThread = std::thread (&IngestPipeline::order, this);
+
+    return (true);
+}
+
+
+void IngestPipeline::abort (void)
+{
+    this->bAbort = true;
+
+    this->clRawQueue.abort     ();
+    this->clDecodedQueue.abort ();
+    this->clOrderedQueue.abort ();
+
+    this->wait ();
+}
+
+
+void IngestPipeline::wait (void)
+{
+    if (this->clFetchThread.joinable () == true)
+    {
+        this->clFetchThread.join ();
+    }
+
+    for (std::thread& clThread : this->vecDecodeThreads)
+    {
+        if (clThread.joinable () == true)
+        {
+            clThread.join ();
+        }
+    }
+    this->vecDecodeThreads.clear ();
+
+    if (this->clOrderThread.joinable () == true)
+    {
+        this->clOrderThread.join ();
+    }
+}
+
+
+void IngestPipeline::fetch (void)
+{
+    // declaration of variables
+    sRawBatch_t   sBatch;
+    sRawMessage_t sMessage;
+    PhaseTimer    clTimer ("ingest_fetch");
+
+    sBatch.iSequence = 0;
+
+    if (this->pclSource->open () == true)
+    {
+        while ((this->bAbort == false) && (this->pclSource->next (sMessage) == true))
+        {
+            sBatch.qvecMessages.push_back (sMessage);
+            if (sBatch.qvecMessages.size () >= C_INGEST_BATCH_SIZE)
+            {
+                if (this->clRawQueue.push (sBatch) == false)
+                {
+                    break;
+                }
+                sBatch.qvecMessages.clear ();
+                sBatch.iSequence++;
+            }
+        }
+
+        if (sBatch.qvecMessages.isEmpty () == false)
+        {
+            this->clRawQueue.push (sBatch);
+        }
+    }
+
+    this->pclSource->close ();
+
+    {
+        QMutexLocker clLocker (&this->clMutex);
+        this->qstrError   = this->pclSource->errorString ();
+        this->qstrStation = this->pclSource->stationName ();
+    }
+
+    this->clRawQueue.close ();
+}
+
+
+void IngestPipeline::decode (void)
+{
+    // declaration of variables
+    LogDecoderRegistry clDecoders;
+    sRawBatch_t        sRaw;
+    sRecordBatch_t     sDecoded;
+    sLogRecord_t       sRecord;
+    PhaseTimer         clTimer ("ingest_decode");
+
+    // each decoder thread has its own decoders
+    while (this->clRawQueue.pop (sRaw) == true)
+    {
+        sDecoded.iSequence = sRaw.iSequence;
+        sDecoded.qvecRecords.clear ();
+        sDecoded.qvecRecords.reserve (sRaw.qvecMessages.size ());
+
+        for (const sRawMessage_t& sMessage : sRaw.qvecMessages)
+        {
+            XMLParser clXML;
+
+            clXML.readXmlFromString (sMessage.qstrMessage);
+
+            if ((clDecoders.decode (sMessage.qstrComponent.trimmed (), clXML.getDocumentNode (), sRecord) == true) &&
+                (sRecord.tTimeStamp > this->tStart) &&
+                (sRecord.tTimeStamp < this->tStop))
+            {
+                sDecoded.qvecRecords.push_back (sRecord);
+            }
+        }
+
+        if (this->clDecodedQueue.push (sDecoded) == false)
+        {
+            break;
+        }
+    }
+
+    // the last decoder marks the end of the decoded batches
+    if (--this->iRunningDecoders == 0)
+    {
+        this->clDecodedQueue.close ();
+    }
+}
+
+
+void IngestPipeline::order (void)
+{
+    // declaration of variables
+    QMap<int, QVector<sLogRecord_t> > qmapPending;
+    QVector<sLogRecord_t>             qvecRecords;
+    QVector<sLogRecord_t>             qvecOrdered;
+    QSet<QString>                     qsetComponents;
+    sRecordBatch_t                    sBatch;
+    sMergeStats_t                     sLocalStats = this->sStats;
+    qint64                            tCurrent    = 0;
+    bool                              bFirst      = true;
+    int                               iNext       = 0;
+    PhaseTimer                        clTimer ("ingest_order");
+
+    // the decoders finish their batches in any order
+    while (this->clDecodedQueue.pop (sBatch) == true)
+    {
+        qmapPending.insert (sBatch.iSequence, sBatch.qvecRecords);
+
+        while (qmapPending.contains (iNext) == true)
+        {
+            qvecRecords = qmapPending.take (iNext);
+            iNext++;
+
+            qvecOrdered.clear ();
+            qvecOrdered.reserve (qvecRecords.size ());
+            for (const sLogRecord_t& sRecord : qvecRecords)
+            {
+                sLocalStats.iNumRecords++;
+
+                // components, that have been queued with the current timestamp
+                if ((bFirst == true) || (sRecord.tTimeStamp != tCurrent))
+                {
+                    if ((bFirst == false) && (sRecord.tTimeStamp < tCurrent))
+                    {
+                        sLocalStats.iNumOutOfOrder++;
+                    }
+                    qsetComponents.clear ();
+                    tCurrent = sRecord.tTimeStamp;
+                    bFirst   = false;
+                }
+
+                if (qsetComponents.contains (sRecord.qstrComponent) == true)
+                {
+                    sLocalStats.iNumDuplicates++;
+                }
+                else
+                {
+                    qsetComponents.insert (sRecord.qstrComponent);
+                    qvecOrdered.push_back (sRecord);
+                }
+            }
+
+            {
+                QMutexLocker clLocker (&this->clMutex);
+                this->sStats = sLocalStats;
+            }
+
+            if (qvecOrdered.isEmpty () == false)
+            {
+                if (this->clOrderedQueue.push (qvecOrdered) == false)
+                {
+                    return;
+                }
+
+                // only one notification, until the records have been taken
+                if (this->bNotified.exchange (true) == false)
+                {
+                    emit this->recordsAvailable ();
+                }
+            }
+        }
+    }
+
+    if (this->bAbort == false)
+    {
+        this->bFinished = true;
+        this->clOrderedQueue.close ();
+        emit this->finished ();
+    }
+}
+
+
+int IngestPipeline::takeRecords (QVector<sLogRecord_t>& qvecRecords)
+{
+    // declaration of variables
+    QVector<sLogRecord_t> qvecBatch;
+
+    // records, that are queued after this point, are notified again
+    this->bNotified = false;
+
+    qvecRecords.clear ();
+    while (this->clOrderedQueue.tryPop (qvecBatch) == true)
+    {
+        qvecRecords += qvecBatch;
+    }
+
+    return (qvecRecords.size ());
+}
+
+
+bool IngestPipeline::isFinished (void) const
+{
+    return (this->bFinished);
+}
+
+
+sMergeStats_t IngestPipeline::stats (void) const
+{
+    QMutexLocker clLocker (&this->clMutex);
+
+    return (this->sStats);
+}
+
+
+QString IngestPipeline::errorString (void) const
+{
+    QMutexLocker clLocker (&this->clMutex);
+
+    return (this->qstrError);
+}
+
+
+QString IngestPipeline::stationName (void) const
+{
+    QMutexLocker clLocker (&this->clMutex);
+
+    return (this->qstrStation);
+}
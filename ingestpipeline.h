@@ -0,0 +1,592 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file ingestpipeline.h
+ *
+ * \brief contains the defintion of the IngestPipeline class.
+ *
+ * ---
+ */
+
+
+#ifndef INGESTPIPELINE_H
+#define INGESTPIPELINE_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QQueue>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QSqlQuery>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "dbinterface.h"
+#include "logdecoder.h"
+#include "recordmerger.h"
+#include "sqldumpreader.h"
+#include "decompressingdevice.h"
+#include "phasetimer.h"
+
+
+#define C_INGEST_PIPELINE_NAME "IngestPipeline"
+
+
+/**
+ * \class BoundedQueue
+ *
+ * \brief Queue with a max. number of items between two stages of a pipeline.
+ *
+ * push () blocks while the queue is full, pop () blocks while it is empty, hence
+ * a fast stage waits for the slow one and the memory of the pipeline is bounded.
+ * After close () the remaining items can still be popped, after abort () all
+ * calls return immediately.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+template <class T> class BoundedQueue
+{
+    private:
+        QMutex         clMutex;
+        QWaitCondition clNotEmpty;
+        QWaitCondition clNotFull;
+        QQueue<T>      qqueueItems;
+        int            iCapacity;
+        bool           bClosed;
+        bool           bAborted;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const int iCapacityValue = max. number of queued items
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        BoundedQueue (const int iCapacityValue)
+        {
+            this->iCapacity = qMax (iCapacityValue, 1);
+            this->bClosed   = false;
+            this->bAborted  = false;
+        }
+
+        /**
+         * \brief Appends an item, blocks while the queue is full.
+         *
+         * @param[in] const T& clItem = item
+         * \return bool = true: OK / false: queue has been aborted or closed
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool push (const T& clItem)
+        {
+            QMutexLocker clLocker (&this->clMutex);
+
+            while ((this->qqueueItems.size () >= this->iCapacity) && (this->bAborted == false) && (this->bClosed == false))
+            {
+                // the next stage is slower
+                PhaseTimer clTimer ("wait_queue_full");
+                this->clNotFull.wait (&this->clMutex);
+            }
+
+            if ((this->bAborted == true) || (this->bClosed == true))
+            {
+                return (false);
+            }
+
+            this->qqueueItems.enqueue (clItem);
+            this->clNotEmpty.wakeOne ();
+
+            return (true);
+        }
+
+        /**
+         * \brief Removes the oldest item, blocks while the queue is empty.
+         *
+         * @param[out] T& clItem = item
+         * \return bool = true: OK / false: queue has been aborted or is closed and empty
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool pop (T& clItem)
+        {
+            QMutexLocker clLocker (&this->clMutex);
+
+            while ((this->qqueueItems.isEmpty () == true) && (this->bAborted == false) && (this->bClosed == false))
+            {
+                // the previous stage is slower
+                PhaseTimer clTimer ("wait_queue_empty");
+                this->clNotEmpty.wait (&this->clMutex);
+            }
+
+            if ((this->bAborted == true) || (this->qqueueItems.isEmpty () == true))
+            {
+                return (false);
+            }
+
+            clItem = this->qqueueItems.dequeue ();
+            this->clNotFull.wakeOne ();
+
+            return (true);
+        }
+
+        /**
+         * \brief Removes the oldest item, if there is one, without blocking.
+         *
+         * @param[out] T& clItem = item
+         * \return bool = true: OK / false: queue is empty
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool tryPop (T& clItem)
+        {
+            QMutexLocker clLocker (&this->clMutex);
+
+            if ((this->bAborted == true) || (this->qqueueItems.isEmpty () == true))
+            {
+                return (false);
+            }
+
+            clItem = this->qqueueItems.dequeue ();
+            this->clNotFull.wakeOne ();
+
+            return (true);
+        }
+
+        /**
+         * \brief Marks the end of the items, waiting readers return after the last item.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void close (void)
+        {
+            QMutexLocker clLocker (&this->clMutex);
+
+            this->bClosed = true;
+            this->clNotEmpty.wakeAll ();
+            this->clNotFull.wakeAll  ();
+        }
+
+        /**
+         * \brief Drops all items and releases all waiting readers and writers.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void abort (void)
+        {
+            QMutexLocker clLocker (&this->clMutex);
+
+            this->bAborted = true;
+            this->qqueueItems.clear ();
+            this->clNotEmpty.wakeAll ();
+            this->clNotFull.wakeAll  ();
+        }
+};
+
+
+/**
+ * \brief undecoded log message, as read from the database or a dump.
+ */
+typedef struct
+{
+    QString qstrComponent;      ///< component column
+    QString qstrMessage;        ///< message column (XML)
+} sRawMessage_t;
+
+
+/**
+ * \class MessageSource
+ *
+ * \brief This is the base class of the sources of undecoded log messages.
+ *
+ * All methods are called by the fetch thread of the pipeline, hence a source may
+ * only create its connections and files inside open ().
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class MessageSource
+{
+    public:
+        virtual ~MessageSource (void);
+
+        /**
+         * \brief Opens the source.
+         *
+         * \return bool = true: OK / false: error (see errorString ())
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        virtual bool open (void) = 0;
+
+        /**
+         * \brief Returns the next message.
+         *
+         * @param[out] sRawMessage_t& sMessage = next message
+         * \return bool = true: OK / false: no more messages or error
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        virtual bool next (sRawMessage_t& sMessage) = 0;
+
+        /**
+         * \brief Closes the source.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        virtual void close (void) = 0;
+
+        /**
+         * \brief Returns the error, that has stopped reading.
+         *
+         * \return QString = error text / empty string: no error
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        virtual QString errorString (void) const = 0;
+
+        /**
+         * \brief Returns the name of the station, that has written the messages.
+         *
+         * \return QString = station name / empty string: unknown
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        virtual QString stationName (void) const = 0;
+};
+
+
+/**
+ * \class DBMessageSource
+ *
+ * \brief Reads the log table of the mcpdb database of a station in time order.
+ *
+ * The database connection is opened by the fetch thread (Qt database connections
+ * can only be used by the thread, that has created them). The older database name
+ * mcpdb07 is tried, if mcpdb contains no messages.
+ *
+ * The MySQL driver transfers a complete result, before the query returns, hence the
+ * messages are fetched in pages, that continue at the timestamp of the last page. The
+ * first messages are available after the first page and an abort of the pipeline waits
+ * for one page at most. Only the components, that are decoded, are fetched.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class DBMessageSource : public MessageSource
+{
+    private:
+        QString                qstrHost;
+        QString                qstrError;
+        DBInterface*           pclDB;
+        QVector<sRawMessage_t> qvecPage;            ///< messages of the current page
+        int                    iPageRow;            ///< next message of the current page
+        QString                qstrPageKey;         ///< timestamp, the next page starts at
+        bool                   bPageKeyInclusive;   ///< next page contains the messages of qstrPageKey
+        bool                   bLastPage;           ///< the current page is the last one
+
+        /**
+         * \brief Fetches the messages of one page and appends them to the current page.
+         *
+         * ---
+         *
+         * @param[in] const QString& qstrCondition = additional condition of the timestamp (SQL)
+         * @param[in] const bool bLimit = true: at most one page of messages / false: all messages
+         * @param[out] QVector<QString>& qvecKeys = timestamps of the fetched messages
+         * \return bool = true: OK / false: query failed
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool queryPage (const QString& qstrCondition, const bool bLimit, QVector<QString>& qvecKeys);
+
+        /**
+         * \brief Replaces the current page by the next page of messages.
+         *
+         * \return bool = true: OK / false: no more messages or error
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool fetchPage (void);
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const QString& qstrHostRef = host name or IP address of the station
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        DBMessageSource (const QString& qstrHostRef);
+
+        ~DBMessageSource (void);
+
+        bool    open        (void) override;
+        bool    next        (sRawMessage_t& sMessage) override;
+        void    close       (void) override;
+        QString errorString (void) const override;
+        QString stationName (void) const override;
+};
+
+
+/**
+ * \class DumpMessageSource
+ *
+ * \brief Reads the log table from a (compressed) mysqldump file.
+ *
+ * The rows are delivered in the order of the dump (order of the primary key). The station is
+ * named by the host of the dump header, a dump of the local server (localhost, 127.0.0.1, ::1)
+ * is named by its file name.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class DumpMessageSource : public MessageSource
+{
+    private:
+        QString              qstrFileName;
+        QString              qstrError;
+        QString              qstrHost;
+        DecompressingDevice* pclDevice;
+        SqlDumpReader*       pclReader;
+        sSqlDumpRow_t        sRow;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const QString& qstrFileNameRef = file name of the dump
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        DumpMessageSource (const QString& qstrFileNameRef);
+
+        ~DumpMessageSource (void);
+
+        bool    open        (void) override;
+        bool    next        (sRawMessage_t& sMessage) override;
+        void    close       (void) override;
+        QString errorString (void) const override;
+        QString stationName (void) const override;
+};
+
+
+/**
+ * \class IngestPipeline
+ *
+ * \brief Loads the log messages of a source in a pipeline of concurrent stages.
+ *
+ * The stages are connected by bounded queues:
+ * - fetch: one thread reads batches of undecoded messages from the source,
+ * - decode: one thread per core parses and decodes the batches,
+ * - order: one thread restores the order of the batches, removes duplicates
+ *   (same timestamp and component) and counts records out of time order,
+ * - append: the GUI thread takes the records with takeRecords () and appends them
+ *   to its TelemetryStore.
+ * recordsAvailable () is emitted, when new records can be taken (only once until
+ * they are taken), finished () after the last record has been queued. The records
+ * are delivered in the order of the source, hence the first days of the history
+ * can be shown, while the rest is still read, and the total time is close to the
+ * time of the slowest stage.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class IngestPipeline : public QObject
+{
+    Q_OBJECT
+
+    private:
+        /**
+         * batch of undecoded messages and of decoded records with their sequence number.
+         */
+        typedef struct
+        {
+            int                    iSequence;
+            QVector<sRawMessage_t> qvecMessages;
+        } sRawBatch_t;
+
+        typedef struct
+        {
+            int                   iSequence;
+            QVector<sLogRecord_t> qvecRecords;
+        } sRecordBatch_t;
+
+        MessageSource* pclSource;
+        qint64         tStart;
+        qint64         tStop;
+
+        BoundedQueue<sRawBatch_t>           clRawQueue;
+        BoundedQueue<sRecordBatch_t>        clDecodedQueue;
+        BoundedQueue<QVector<sLogRecord_t>> clOrderedQueue;
+
+        std::thread              clFetchThread;
+        std::vector<std::thread> vecDecodeThreads;
+        std::thread              clOrderThread;
+        std::atomic<int>         iRunningDecoders;
+        std::atomic<bool>        bNotified;
+        std::atomic<bool>        bAbort;
+        std::atomic<bool>        bFinished;
+
+        mutable QMutex clMutex;
+        sMergeStats_t  sStats;
+        QString        qstrError;
+        QString        qstrStation;
+
+        void fetch  (void);
+        void decode (void);
+        void order  (void);
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] MessageSource* pclSourceRef = source, the pipeline takes the ownership
+         * @param[in] const qint64 tStartValue = messages older than this are skipped (epoch seconds)
+         * @param[in] const qint64 tStopValue = messages newer than this are skipped (epoch seconds)
+         * @param[in] QObject* pclParent = parent object
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        IngestPipeline (MessageSource* pclSourceRef, const qint64 tStartValue, const qint64 tStopValue, QObject* pclParent = NULL);
+
+        /**
+         * \brief This is the class destructor, a running pipeline is aborted.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        ~IngestPipeline (void);
+
+        /**
+         * \brief Starts the threads of all stages.
+         *
+         * \return bool = true: OK / false: already started
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool start (void);
+
+        /**
+         * \brief Stops all stages and waits for their threads.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void abort (void);
+
+        /**
+         * \brief Waits for the threads of all stages, after finished () has been emitted.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void wait (void);
+
+        /**
+         * \brief Takes the records, that have been queued since the last call (non-blocking).
+         *
+         * @param[out] QVector<sLogRecord_t>& qvecRecords = records in the order of the source
+         * \return int = number of records
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        int takeRecords (QVector<sLogRecord_t>& qvecRecords);
+
+        /**
+         * \brief Returns true, after the last record has been queued.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool isFinished (void) const;
+
+        /**
+         * \brief Returns the statistics of the records, that have been queued so far.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        sMergeStats_t stats (void) const;
+
+        /**
+         * \brief Returns the error of the source.
+         *
+         * \return QString = error text / empty string: no error
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QString errorString (void) const;
+
+        /**
+         * \brief Returns the station name of the source (valid after finished ()).
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QString stationName (void) const;
+
+    signals:
+        void recordsAvailable (void);
+        void finished         (void);
+};
+
+#endif // INGESTPIPELINE_H
@@ -0,0 +1,212 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file logdecoder.cpp
+ *
+ * \brief contains the implementation of the log component decoders and the decoder registry.
+ *
+ * ---
+ */
+
+
+#include "logdecoder.h"
+#include "xmlparses.h"
+#include "phasetimer.h"
+
+#include <QVarLengthArray>
+
+#include <algorithm>
+#include <limits>
+
+
+LogComponentDecoder::~LogComponentDecoder (void)
+{
+}
+
+
+bool GenericComponentDecoder::decode (const QDomNode& clMessage, sLogRecord_t& sRecord)
+{
+    this->qvecFields.clear ();
+
+    // all leaf nodes below the message node: elements with text, but without child elements
+    XMLParser::walkSubNodes (clMessage, [this] (const QDomNode& clNode)
+    {
+        // declaration of variables
+        sLogField_t sField;
+
+        if ((clNode.firstChild ().isText ()      == true) &&
+            (clNode.firstChildElement ().isNull () == true))
+        {
+            sField.qstrTag   = clNode.nodeName ();
+            sField.qstrValue = clNode.firstChild ().nodeValue ();
+            this->qvecFields.push_back (sField);
+        }
+
+        return (false);
+    });
+
+    return (this->decodeFields (this->qvecFields.constData (), this->qvecFields.size (), sRecord));
+}
+
+
+bool GenericComponentDecoder::decodeFields (const sLogField_t* psFields, const int iNumFields, sLogRecord_t& sRecord)
+{
+    // declaration of variables
+    int      iCounter;
+    int      iIndex;
+    int      iOccurrence;
+    double   dValue;
+    QString  qstrDate;
+    QString  qstrTime;
+    QString  qstrChannel;
+    QVarLengthArray<bool, 32> qvlaUsed;
+
+    sRecord.qvecValues.fill (std::numeric_limits<double>::quiet_NaN (), this->qvecChannels.size ());
+    qvlaUsed.resize (this->qvecChannels.size ());
+    std::fill (qvlaUsed.begin (), qvlaUsed.end (), false);
+
+    for (iCounter = 0; iCounter < iNumFields; iCounter++)
+    {
+        const QString& qstrTag   = psFields [iCounter].qstrTag;
+        const QString& qstrValue = psFields [iCounter].qstrValue;
+
+        if (qstrTag == QLatin1String ("date"))
+        {
+            if (qstrDate.isNull () == true)
+            {
+                qstrDate = qstrValue;
+            }
+        }
+        else if (qstrTag == QLatin1String ("time"))
+        {
+            if (qstrTime.isNull () == true)
+            {
+                qstrTime = qstrValue;
+            }
+        }
+        else if ((qstrTag != QLatin1String ("component")) &&
+                 (NumberParser::toDouble (qstrValue, dValue) == true))
+        {
+            // repeated tags inside one message get their own channel
+            iOccurrence = 1;
+            qstrChannel = qstrTag;
+            iIndex      = this->qhashChannelIndex.value (qstrChannel, -1);
+            while ((iIndex >= 0) && (qvlaUsed [iIndex] == true))
+            {
+                iOccurrence++;
+                qstrChannel = qstrTag + QLatin1Char ('_') + QString::number (iOccurrence);
+                iIndex      = this->qhashChannelIndex.value (qstrChannel, -1);
+            }
+
+            if (iIndex < 0)
+            {
+                iIndex = this->qvecChannels.size ();
+                this->qvecChannels.push_back (qstrChannel);
+                this->qhashChannelIndex.insert (qstrChannel, iIndex);
+                sRecord.qvecValues.push_back (std::numeric_limits<double>::quiet_NaN ());
+                qvlaUsed.push_back (false);
+            }
+
+            sRecord.qvecValues [iIndex] = dValue;
+            qvlaUsed [iIndex] = true;
+        }
+    }
+
+    sRecord.qvecChannels = this->qvecChannels;
+
+    return (this->clTimeDecoder.decode (qstrDate, qstrTime, sRecord.tTimeStamp));
+}
+
+
+LogComponentDecoder* GenericComponentDecoder::clone (void) const
+{
+    return (new GenericComponentDecoder ());
+}
+
+
+LogDecoderRegistry::LogDecoderRegistry (void)
+{
+    this->pclDefaultPrototype = new GenericComponentDecoder ();
+
+    this->registerDecoder (QString::fromLatin1 (HWStatusTable::pcComponent), new TableComponentDecoder<HWStatusTable> ());
+    this->registerDecoder (QString::fromLatin1 (GPStatusTable::pcComponent), new TableComponentDecoder<GPStatusTable> ());
+}
+
+
+LogDecoderRegistry::~LogDecoderRegistry (void)
+{
+    qDeleteAll (this->qhashDecoders);
+    qDeleteAll (this->qhashPrototypes);
+    delete (this->pclDefaultPrototype);
+}
+
+
+void LogDecoderRegistry::registerDecoder (const QString& qstrComponent, LogComponentDecoder* pclPrototype)
+{
+    delete (this->qhashPrototypes.take (qstrComponent));
+    delete (this->qhashDecoders.take   (qstrComponent));
+
+    this->qhashPrototypes.insert (qstrComponent, pclPrototype);
+}
+
+
+LogComponentDecoder* LogDecoderRegistry::decoder (const QString& qstrComponent)
+{
+    // declaration of variables
+    LogComponentDecoder* pclDecoder = this->qhashDecoders.value (qstrComponent, NULL);
+
+    if (pclDecoder == NULL)
+    {
+        pclDecoder = this->qhashPrototypes.value (qstrComponent, this->pclDefaultPrototype)->clone ();
+        this->qhashDecoders.insert (qstrComponent, pclDecoder);
+    }
+
+    return (pclDecoder);
+}
+
+
+bool LogDecoderRegistry::decode (const QString& qstrComponent, const QDomNode& clMessage, sLogRecord_t& sRecord)
+{
+    PhaseTimer clTimer ("log_decode");
+
+    sRecord.qstrComponent = qstrComponent;
+
+    return (this->decoder (qstrComponent)->decode (clMessage, sRecord));
+}
+
+
+bool LogDecoderRegistry::decodeFields (const QString& qstrComponent, const sLogField_t* psFields, const int iNumFields, sLogRecord_t& sRecord)
+{
+    PhaseTimer clTimer ("log_decode");
+
+    sRecord.qstrComponent = qstrComponent;
+
+    return (this->decoder (qstrComponent)->decodeFields (psFields, iNumFields, sRecord));
+}
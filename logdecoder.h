@@ -0,0 +1,360 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file logdecoder.h
+ *
+ * \brief contains the defintion of the log component decoders and the decoder registry.
+ *
+ * ---
+ */
+
+
+#ifndef LOGDECODER_H
+#define LOGDECODER_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QDomNode>
+
+#include "statusdecoder.h"
+#include "telemetrystore.h"
+#include "timestampdecoder.h"
+
+
+#define C_LOG_DECODER_NAME "LogDecoder"
+
+
+/**
+ * leaf node of a log message (element with text, but without child elements), as
+ * delivered by streaming XML readers.
+ */
+typedef struct
+{
+    QString qstrTag;        ///< tag name
+    QString qstrValue;      ///< node text
+} sLogField_t;
+
+
+/**
+ * \class LogComponentDecoder
+ *
+ * \brief This is the base class of all log component decoders.
+ *
+ * A decoder converts the XML message of one log component into a record with
+ * timestamp and channel values. One decoder instance is used per component.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class LogComponentDecoder
+{
+    public:
+        virtual ~LogComponentDecoder (void);
+
+        /**
+         * \brief Decodes one message.
+         *
+         * @param[in] const QDomNode& clMessage = message node (or document)
+         * @param[out] sLogRecord_t& sRecord = decoded record, the component name is set by the caller
+         * \return bool = true: OK / false: message could not be decoded (e.g. no timestamp)
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        virtual bool decode (const QDomNode& clMessage, sLogRecord_t& sRecord) = 0;
+
+        /**
+         * \brief Decodes one message from its leaf nodes.
+         *
+         * Used by streaming readers, that do not build a DOM tree.
+         *
+         * @param[in] const sLogField_t* psFields = leaf nodes of the message in document order
+         * @param[in] const int iNumFields = number of leaf nodes
+         * @param[out] sLogRecord_t& sRecord = decoded record, the component name is set by the caller
+         * \return bool = true: OK / false: message could not be decoded (e.g. no timestamp)
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        virtual bool decodeFields (const sLogField_t* psFields, const int iNumFields, sLogRecord_t& sRecord) = 0;
+
+        /**
+         * \brief Creates a new decoder instance of the same type.
+         *
+         * Is used by the registry to create one decoder instance per component.
+         *
+         * \return LogComponentDecoder* = new decoder instance, owned by the caller
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        virtual LogComponentDecoder* clone (void) const = 0;
+};
+
+
+/**
+ * \class TableComponentDecoder
+ *
+ * \brief Component decoder generated from a status field table (see statusdecoder.h).
+ *
+ * The channel names are the tag names of the table, the values are scaled as
+ * defined inside the table.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+template <typename Table>
+class TableComponentDecoder : public LogComponentDecoder
+{
+    private:
+        /**
+         * table generated decoder.
+         */
+        StatusDecoder<Table> clDecoder;
+
+        /**
+         * channel names, shared with all records.
+         */
+        QVector<QString> qvecChannels;
+
+    public:
+        TableComponentDecoder (void)
+        {
+            for (const sStatusField_t<typename Table::Message>& sField : Table::arsFields)
+            {
+                this->qvecChannels.push_back (QString::fromLatin1 (sField.pcTagName));
+            }
+        }
+
+        bool decode (const QDomNode& clMessage, sLogRecord_t& sRecord) override
+        {
+            // declaration of variables
+            bool bRetValue;
+            int  iCounter;
+            typename Table::Message sMsg;
+
+            bRetValue = this->clDecoder.decode (clMessage, sMsg);
+
+            sRecord.tTimeStamp   = sMsg.sTimeStamp;
+            sRecord.qvecChannels = this->qvecChannels;
+            sRecord.qvecValues.resize (this->qvecChannels.size ());
+            for (iCounter = 0; iCounter < this->qvecChannels.size (); iCounter++)
+            {
+                sRecord.qvecValues [iCounter] = sMsg.*(Table::arsFields [iCounter].pdMember);
+            }
+
+            return (bRetValue);
+        }
+
+        bool decodeFields (const sLogField_t* psFields, const int iNumFields, sLogRecord_t& sRecord) override
+        {
+            // declaration of variables
+            bool bRetValue;
+            int  iCounter;
+            typename Table::Message sMsg;
+
+            this->clDecoder.beginMessage ();
+            for (iCounter = 0; iCounter < iNumFields; iCounter++)
+            {
+                if (this->clDecoder.addField (psFields [iCounter].qstrTag, psFields [iCounter].qstrValue) == true)
+                {
+                    break;
+                }
+            }
+            bRetValue = this->clDecoder.endMessage (sMsg);
+
+            sRecord.tTimeStamp   = sMsg.sTimeStamp;
+            sRecord.qvecChannels = this->qvecChannels;
+            sRecord.qvecValues.resize (this->qvecChannels.size ());
+            for (iCounter = 0; iCounter < this->qvecChannels.size (); iCounter++)
+            {
+                sRecord.qvecValues [iCounter] = sMsg.*(Table::arsFields [iCounter].pdMember);
+            }
+
+            return (bRetValue);
+        }
+
+        LogComponentDecoder* clone (void) const override
+        {
+            return (new TableComponentDecoder<Table> ());
+        }
+};
+
+
+/**
+ * \class GenericComponentDecoder
+ *
+ * \brief Component decoder for all components without a field table.
+ *
+ * Every leaf node with a numeric value becomes a channel, named by its tag. If
+ * a tag exists more than once inside a message, the following nodes are named
+ * "tag_2", "tag_3", ... . The fields "date" and "time" are used as timestamp,
+ * the "component" field and non numeric values are ignored.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class GenericComponentDecoder : public LogComponentDecoder
+{
+    private:
+        /**
+         * all channels found so far, shared with the records.
+         */
+        QVector<QString> qvecChannels;
+
+        /**
+         * channel name -> index inside qvecChannels
+         */
+        QHash<QString, int> qhashChannelIndex;
+
+        /**
+         * cache for the timestamp conversion.
+         */
+        TimestampDecoder clTimeDecoder;
+
+        /**
+         * leaf nodes of the DOM message, that is decoded.
+         */
+        QVector<sLogField_t> qvecFields;
+
+    public:
+        bool decode (const QDomNode& clMessage, sLogRecord_t& sRecord) override;
+
+        bool decodeFields (const sLogField_t* psFields, const int iNumFields, sLogRecord_t& sRecord) override;
+
+        LogComponentDecoder* clone (void) const override;
+};
+
+
+/**
+ * \class LogDecoderRegistry
+ *
+ * \brief This class dispatches log messages to the decoder of their component.
+ *
+ * The decoders for HW_STATUS and GPS_STATUS are registered by default, all other
+ * components are decoded by a GenericComponentDecoder. Further decoders can be
+ * registered with registerDecoder(). Each component gets its own decoder instance,
+ * hence each decoder writes into its own series of the TelemetryStore.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class LogDecoderRegistry
+{
+    private:
+        /**
+         * decoder prototypes, key is the component name.
+         */
+        QHash<QString, LogComponentDecoder*> qhashPrototypes;
+
+        /**
+         * decoder instances, key is the component name.
+         */
+        QHash<QString, LogComponentDecoder*> qhashDecoders;
+
+        /**
+         * prototype for components without registered decoder.
+         */
+        LogComponentDecoder* pclDefaultPrototype;
+
+        /**
+         * \brief Returns the decoder instance of a component, creates it on first use.
+         */
+        LogComponentDecoder* decoder (const QString& qstrComponent);
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * Registers the default decoders.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        LogDecoderRegistry (void);
+
+        /**
+         * \brief This is the class destructor.
+         *
+         * Deletes all decoders.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        ~LogDecoderRegistry (void);
+
+        /**
+         * \brief Registers a decoder for a component.
+         *
+         * The registry takes ownership of the decoder. An already registered decoder
+         * of the same component is replaced.
+         *
+         * @param[in] const QString& qstrComponent = component name
+         * @param[in] LogComponentDecoder* pclPrototype = decoder prototype
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void registerDecoder (const QString& qstrComponent, LogComponentDecoder* pclPrototype);
+
+        /**
+         * \brief Decodes one message with the decoder of its component.
+         *
+         * @param[in] const QString& qstrComponent = component name of the message
+         * @param[in] const QDomNode& clMessage = message node (or document)
+         * @param[out] sLogRecord_t& sRecord = decoded record
+         * \return bool = true: OK / false: message could not be decoded
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool decode (const QString& qstrComponent, const QDomNode& clMessage, sLogRecord_t& sRecord);
+
+        /**
+         * \brief Decodes one message from its leaf nodes with the decoder of its component.
+         *
+         * @param[in] const QString& qstrComponent = component name of the message
+         * @param[in] const sLogField_t* psFields = leaf nodes of the message in document order
+         * @param[in] const int iNumFields = number of leaf nodes
+         * @param[out] sLogRecord_t& sRecord = decoded record
+         * \return bool = true: OK / false: message could not be decoded
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool decodeFields (const QString& qstrComponent, const sLogField_t* psFields, const int iNumFields, sLogRecord_t& sRecord);
+
+    private:
+        LogDecoderRegistry (const LogDecoderRegistry&);
+        LogDecoderRegistry& operator= (const LogDecoderRegistry&);
+};
+
+#endif // LOGDECODER_H
@@ -31,6 +31,10 @@
 #include "ui_mainwindow.h"
 #include "dbinterface.h"
 #include "xmlparses.h"
+#include "logdecoder.h"
+#include "recordmerger.h"
+#include "measdocloader.h"
+#include "ingestpipeline.h"
 
 #include <QSqlQuery>
 #include <QDebug>
@@ -38,381 +42,903 @@
 #include <QFileDialog>
 #include <QDomDocument>
 #include <QMessageBox>
+#include <QFileInfo>
+#include <QApplication>
+#include <QtConcurrent>
+
+#include <cmath>
+
+/**
+ * GPS states, that are shaded in the GPS plot: sync_state below "synced" value
+ * and number of satellites below min. number.
+ */
+#define C_GPS_SYNC_STATE_SYNCED 1
+#define C_GPS_MIN_SATELLITES    4
+
+/**
+ * min. distance of two log messages, that is shown as logging gap, as multiple of
+ * the nominal logging period.
+ */
+#define C_LOG_GAP_FACTOR        3.0
+
+/**
+ * min. time between two refreshs of the plots, while the log messages are loaded (5 Hz).
+ */
+#define C_PLOT_REFRESH_MS       200
 
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
-    ui(new Ui::MainWindow)
+    ui(new Ui::MainWindow),
+    clSyncIntervals ("sync_state"),
+    clSatsIntervals ("num_sats"),
+    clFleet (C_GPS_SYNC_STATE_SYNCED)
 {
     ui->setupUi(this);
-    qvecHWStatus.clear ();
+    clTelemetry.clear ();
+
+    this->tPlotOrigin   = 0;
+    this->bPlotUpdating = false;
+    this->pclFleetView  = NULL;
+    this->pclPhaseView  = NULL;
+    this->pclIngest     = NULL;
+    this->bIngestMerge  = false;
+
+    GapDetector::detect (QVector<qint64> (), C_LOG_GAP_FACTOR, this->sHwCompleteness);
+    GapDetector::detect (QVector<qint64> (), C_LOG_GAP_FACTOR, this->sGpsCompleteness);
+    this->pclCompletenessLabel = new QLabel (this);
+    ui->statusBar->addPermanentWidget (this->pclCompletenessLabel);
+    this->pclEnergyLabel = new QLabel (this);
+    ui->statusBar->addPermanentWidget (this->pclEnergyLabel);
+    this->pclMergeLabel = new QLabel (this);
+    ui->statusBar->addPermanentWidget (this->pclMergeLabel);
+
+    this->qvecHwPlots.push_back ({ui->plotTemperature,       "temp",        "System Temperature [degree C]", -1, {0, 0, QCPRange (), QCPRange ()}});
+    this->qvecHwPlots.push_back ({ui->plotTemperatureSensor, "temp_sensor", "Sensor Temperature [degree C]", -1, {0, 0, QCPRange (), QCPRange ()}});
+    this->qvecHwPlots.push_back ({ui->plotBatteryVoltage,    "batt_volt",   "Battery Voltage [V]",           -1, {0, 0, QCPRange (), QCPRange ()}});
+    this->qvecHwPlots.push_back ({ui->plotPowerConsumption,  "power",       "Power Consumption [W]",         -1, {0, 0, QCPRange (), QCPRange ()}});
+    this->sGpsProgress = {0, 0, QCPRange (), QCPRange ()};
+
+    // zooming switches between raw data and the downsampled tiers
+    for (const sPlotBinding_t& sBinding : this->qvecHwPlots)
+    {
+        connect (sBinding.pclPlot->xAxis, SIGNAL (rangeChanged (QCPRange)), this, SLOT (hwPlotRangeChanged (QCPRange)));
+    }
+
+    // while loading, the plots are refreshed at most every C_PLOT_REFRESH_MS
+    this->clRefreshTimer.setSingleShot (true);
+    this->clRefreshTimer.setInterval   (C_PLOT_REFRESH_MS);
+    connect (&this->clRefreshTimer, SIGNAL (timeout ()), this, SLOT (refreshTelemetry ()));
+
+    // the MeasDoc files are decoded in the background and merged by the GUI thread
+    connect (&this->clMeasDocWatcher, SIGNAL (finished ()), this, SLOT (measDocsLoaded ()));
 }
 
 MainWindow::~MainWindow()
 {
+    // the background load writes to the members of the window
+    this->clMeasDocWatcher.waitForFinished ();
     delete ui;
 }
 
 
 void MainWindow::on_pbReadLog_clicked(void)
 {
-    QSqlQuery   clQuery;
-    int         iCounter;
-    QDomNode    clTargetNode;
-    QString     qstrTemp1;
-    QString     qstrTemp2;
-    QVector<QString> qvecXmlPath;
+    QString qstrHost;
+
+    // the database is read and decoded in the background, the plots grow while loading
+    qstrHost = ui->teIP->toPlainText ().trimmed ();
+    this->startIngest (new DBMessageSource (qstrHost), qstrHost);
+}
 
-    // HW Status
-    qstrTemp1 = ui->teIP->toPlainText ();
-    DBInterface* pclDB = new DBInterface ("aduuser", "neptun", "mcpdb", qstrTemp1, 3306, "mcpdb");
-    clQuery = pclDB->execQuery ("select message from log where component=\'HW_STATUS\' order by timestamp asc;");
 
-    if (clQuery.size() <= 0)
+void MainWindow::on_pbReadFromMeasDoc_clicked (void)
+{
+    QStringList qstrlMeasDocNames;
+
+    // several MeasDocs are merged into one history per station
+    qstrlMeasDocNames = QFileDialog::getOpenFileNames (this, "Open MeasDoc XML", "", "MeasDoc XML (*.xml *.xml.gz *.xml.zst)");
+    if (qstrlMeasDocNames.isEmpty () == false)
     {
-        delete (pclDB);
-        pclDB = new DBInterface ("aduuser", "neptun", "mcpdb07", qstrTemp1, 3306, "mcpdb07");
-        clQuery = pclDB->execQuery ("select message from log where component=\'HW_STATUS\' order by timestamp asc;");
+        this->loadMeasDocs (qstrlMeasDocNames);
     }
+}
+
+
+void MainWindow::on_pbReadMeasDocFolder_clicked (void)
+{
+    QString     qstrDirectory;
+    QStringList qstrlMeasDocNames;
 
-    if (clQuery.size() > 0)
+    qstrDirectory = QFileDialog::getExistingDirectory (this, "Open MeasDoc Folder");
+    if (qstrDirectory.isEmpty () == false)
     {
-        clQuery.first();
-        this->qvecHWStatus.clear();
-        for (iCounter = 0; iCounter < clQuery.size(); iCounter++)
+        qstrlMeasDocNames = MeasDocLoader::findFiles (qstrDirectory);
+        if (qstrlMeasDocNames.isEmpty () == true)
         {
-            //qDebug () << "message:" << clQuery.value(0);
-            XMLParser*  pclXML = new XMLParser ();
-            sHWStatus_t sMsg;
+            QMessageBox::warning(this, "No MeasDoc XML", "The folder contains no MeasDoc XML files!");
+        }
+        else
+        {
+            this->loadMeasDocs (qstrlMeasDocNames);
+        }
+    }
+}
 
-            pclXML->readXmlFromString(clQuery.value(0).toString());
 
-            clTargetNode.clear();
-            pclXML->getSubNodeValue ("date", clTargetNode, qstrTemp1);
-            pclXML->getSubNodeValue ("time", clTargetNode, qstrTemp2);
-            qstrTemp1 += " " + qstrTemp2;
-            sMsg.sTimeStamp = QDateTime::fromString(qstrTemp1, "yyyy-MM-dd hh:mm:ss").toUTC().toTime_t();
+void MainWindow::on_pbReadSqlDump_clicked (void)
+{
+    QString qstrFileName;
 
-            clTargetNode.clear();
-            pclXML->getSubNodeValue ("temp", clTargetNode, qstrTemp1);
-            sMsg.dTemperatureSystem = qstrTemp1.toDouble();
+    qstrFileName = QFileDialog::getOpenFileName (this, "Open mcpdb SQL Dump", "", "SQL Dump (*.sql *.sql.gz *.sql.zst)");
+    if (qstrFileName.isEmpty () == false)
+    {
+        // the station name is taken from the dump header, when the dump has been read
+        this->startIngest (new DumpMessageSource (qstrFileName), QString ());
+    }
+}
 
-            clTargetNode.clear();
-            pclXML->getSubNodeValue ("temp_sensor", clTargetNode, qstrTemp1);
-            sMsg.dTemperatureSensor = qstrTemp1.toDouble();
 
-            clTargetNode.clear();
-            pclXML->getSubNodeValue ("batt_volt", clTargetNode, qstrTemp1);
-            sMsg.dBattVoltage = qstrTemp1.toDouble() / 10.0;
+bool MainWindow::loadMeasDocs (const QStringList& qstrlMeasDocNames)
+{
+    if (this->clMeasDocWatcher.isRunning () == true)
+    {
+        ui->statusBar->showMessage ("MeasDoc files are still being read ...");
+        return (false);
+    }
 
-            clTargetNode.clear();
-            pclXML->getSubNodeValue ("batt1_curr", clTargetNode, qstrTemp1);
-            sMsg.dBattCurr1 = qstrTemp1.toDouble() / 100.0;
+    this->qmapMeasDocStations.clear ();
+    this->qstrlMeasDocFailed.clear  ();
 
-            clTargetNode.clear();
-            pclXML->getSubNodeValue ("batt2_curr", clTargetNode, qstrTemp1);
-            sMsg.dBattCurr2 = qstrTemp1.toDouble() / 100.0;
+    // the files are read and decoded by the thread pool, the window stays responsive
+    QApplication::setOverrideCursor (Qt::BusyCursor);
+    ui->statusBar->showMessage (QString ("reading %1 MeasDoc file(s) ...").arg (qstrlMeasDocNames.size ()));
+    this->clMeasDocWatcher.setFuture (QtConcurrent::run ([this, qstrlMeasDocNames] ()
+    {
+        return (this->clMeasDocLoader.load (qstrlMeasDocNames, this->qmapMeasDocStations, &this->qstrlMeasDocFailed));
+    }));
 
-            QDateTime clStartDate (this->ui->startDate->date());
-            QDateTime clStopDate  (this->ui->stopDate->date ());
-            if ((sMsg.sTimeStamp > clStartDate.toSecsSinceEpoch()) &&
-                (sMsg.sTimeStamp < clStopDate.toSecsSinceEpoch ()))
-            {
-                this->qvecHWStatus.push_back(sMsg);
-            }
+    return (true);
+}
 
-            delete (pclXML);
 
-            clQuery.next();
-        }
-        delete (pclDB);
+void MainWindow::measDocsLoaded (void)
+{
+    // declaration of variables
+    QMap<QString, QVector<sMeasDocFile_t> > qmapStations;
+    QString                                 qstrShown;
+    QVector<RecordSource*>                  qvecSources;
+    bool                                    bMerge;
+
+    QApplication::restoreOverrideCursor ();
+    ui->statusBar->clearMessage ();
+
+    // the decoded files are only needed for the merge
+    qmapStations.swap (this->qmapMeasDocStations);
+
+    if (this->qstrlMeasDocFailed.isEmpty () == false)
+    {
+        QMessageBox::warning(this, "Unable to open MeasDoc XML", "Unable to open MeasDoc XML file(s)!\n" + this->qstrlMeasDocFailed.mid (0, 10).join ("\n"));
+    }
+
+    if (qmapStations.isEmpty () == true)
+    {
+        return;
+    }
 
+    // a background load would append to the telemetry, that is replaced here
+    delete (this->pclIngest);
+    this->pclIngest = NULL;
 
-        // GPS Status
-        qstrTemp1 = ui->teIP->toPlainText ();
-        DBInterface* pclDB = new DBInterface ("aduuser", "neptun", "mcpdb", qstrTemp1, 3306, "mcpdb");
-        clQuery = pclDB->execQuery ("select message from log where component=\'GPS_STATUS\' order by timestamp asc;");
-        if (clQuery.size() > 0)
+    // the merge condition is the same as for a background load, the loaded station keeps its key, even if the
+    // files name it differently (a database load is keyed by the host), and gets the files of the first station
+    // unless they contain the loaded station
+    qstrShown = qmapStations.firstKey ();
+    bMerge    = (ui->cbMergeSources->isChecked () == true) && (this->clTelemetry.components ().isEmpty () == false);
+    if ((bMerge == true) && (qmapStations.contains (this->qstrStation) == true))
+    {
+        qstrShown = this->qstrStation;
+    }
+
+    // all other stations only update their fleet aggregates
+    for (QMap<QString, QVector<sMeasDocFile_t> >::const_iterator itStation = qmapStations.constBegin ();
+         itStation != qmapStations.constEnd (); ++itStation)
+    {
+        for (const sMeasDocFile_t& sFile : itStation.value ())
         {
-            clQuery.first();
-            this->qvecGPStatus.clear();
-            for (iCounter = 0; iCounter < clQuery.size(); iCounter++)
-            {
-                //qDebug () << "message:" << clQuery.value(0);
-                XMLParser*  pclXML = new XMLParser ();
-                sGPStatus_t sMsg;
+            qvecSources.push_back (new RecordVectorSource (sFile.qvecRecords));
+        }
 
-                pclXML->readXmlFromString(clQuery.value(0).toString());
+        if (itStation.key () == qstrShown)
+        {
+            this->loadSources (qvecSources, itStation.key (), bMerge);
+        }
+        else
+        {
+            TelemetryStore clStore;
+            RecordMerger::merge (qvecSources, clStore);
+            this->updateFleet (itStation.key (), clStore);
+        }
 
-                clTargetNode.clear();
-                pclXML->getSubNodeValue ("date", clTargetNode, qstrTemp1);
-                pclXML->getSubNodeValue ("time", clTargetNode, qstrTemp2);
-                qstrTemp1 += " " + qstrTemp2;
-                sMsg.sTimeStamp = QDateTime::fromString(qstrTemp1, "yyyy-MM-dd hh:mm:ss").toUTC().toTime_t();
+        qDeleteAll (qvecSources);
+        qvecSources.clear ();
+    }
+}
 
-                clTargetNode.clear();
-                pclXML->getSubNodeValue ("num_sats", clTargetNode, qstrTemp1);
-                sMsg.dNumSats = qstrTemp1.toDouble();
 
-                clTargetNode.clear();
-                pclXML->getSubNodeValue ("sync_state", clTargetNode, qstrTemp1);
-                sMsg.dSyncState = qstrTemp1.toDouble();
+bool MainWindow::loadSources (const QVector<RecordSource*>& qvecSources, const QString& qstrStationName, const bool bMerge)
+{
+    // declaration of variables
+    QVector<RecordSource*> qvecMerged;
+    TelemetryStore         clMerged;
+    StoreRecordSource*     pclLoaded = NULL;
+    sMergeStats_t          sStats;
+    bool                   bRetValue;
+    PhaseTimer             clTimer ("load_sources");
+
+    // in merge mode the loaded telemetry is the first source, hence it wins over duplicates
+    if ((bMerge == true) && (this->clTelemetry.components ().isEmpty () == false))
+    {
+        pclLoaded = new StoreRecordSource (this->clTelemetry);
+        qvecMerged.push_back (pclLoaded);
+    }
+    else
+    {
+        this->qstrStation = qstrStationName;
+    }
+    qvecMerged += qvecSources;
 
-                this->qvecGPStatus.push_back(sMsg);
+    bRetValue = RecordMerger::merge (qvecMerged, clMerged, &sStats);
+    delete (pclLoaded);
 
-                delete (pclXML);
+    this->clTelemetry = clMerged;
 
-                clQuery.next();
+    this->showMergeStats (sStats);
+    this->showTelemetry  ();
+    this->updateFleet    (this->qstrStation, this->clTelemetry);
 
-            }
+    return (bRetValue);
+}
+
+
+bool MainWindow::showTelemetry (void)
+{
+    bool       bRetValue;
+    PhaseTimer clTimer ("show_telemetry");
+
+    bRetValue = this->updatePlotOrigin   ();
+    this->plotHwStatusGraphs (this->clTelemetry.series (HWStatusTable::pcComponent));
+    this->showEnergySummary  (this->clTelemetry.series (HWStatusTable::pcComponent));
+    this->showCompletenessSummary ();
+    this->plotGPSStatusGraphs(this->clTelemetry.series (GPStatusTable::pcComponent));
+
+    return (bRetValue);
+}
+
+
+void MainWindow::refreshTelemetry (void)
+{
+    // declaration of variables
+    qint64     tOrigin  = this->tPlotOrigin;
+    bool       bHwFull  = false;
+    bool       bHwNew   = false;
+    bool       bGpsFull;
+    bool       bGpsNew;
+    PhaseTimer clTimer ("refresh_telemetry");
+    const TelemetrySeries& clHwSeries  = this->clTelemetry.series (HWStatusTable::pcComponent);
+    const TelemetrySeries& clGpsSeries = this->clTelemetry.series (GPStatusTable::pcComponent);
+
+    // a new origin moves all graphs, otherwise each series is plotted completely, if it is another series or
+    // gets its first rows, its new rows are appended or it is left as it is, if it has no new rows
+    bGpsFull = (this->sGpsProgress.uiContentId != clGpsSeries.contentId ()) ||
+               (this->sGpsProgress.iNumRows    >  clGpsSeries.size ()) ||
+               ((this->sGpsProgress.iNumRows   == 0) && (clGpsSeries.size () > 0)) ||
+               (ui->plotGPS->graphCount ()     <  2);
+    bGpsNew  = (this->sGpsProgress.iNumRows    <  clGpsSeries.size ());
+
+    for (const sPlotBinding_t& sBinding : this->qvecHwPlots)
+    {
+        if ((sBinding.sProgress.uiContentId != clHwSeries.contentId ()) ||
+            (sBinding.sProgress.iNumRows    >  clHwSeries.size ()) ||
+            ((sBinding.sProgress.iNumRows   == 0) && (clHwSeries.size () > 0)) ||
+            (sBinding.pclPlot->graphCount () < 4))
+        {
+            bHwFull = true;
+        }
+
+        if (sBinding.sProgress.iNumRows < clHwSeries.size ())
+        {
+            bHwNew = true;
+        }
+    }
+
+    if ((this->updatePlotOrigin () == false) || (tOrigin != this->tPlotOrigin))
+    {
+        this->showTelemetry ();
+    }
+    else
+    {
+        if (bHwFull == true)
+        {
+            this->plotHwStatusGraphs (clHwSeries);
+        }
+        else if (bHwNew == true)
+        {
+            this->appendHwStatusGraphs (clHwSeries);
         }
-        delete (pclDB);
 
+        if (bGpsFull == true)
+        {
+            this->plotGPSStatusGraphs (clGpsSeries);
+        }
+        else if (bGpsNew == true)
+        {
+            this->appendGPSStatusGraphs (clGpsSeries);
+        }
 
-        this->plotHwStatusGraphs (this->qvecHWStatus);
-        this->plotGPSStatusGraphs(this->qvecGPStatus);
+        if ((bHwFull == true) || (bHwNew == true))
+        {
+            this->showEnergySummary (clHwSeries);
+        }
+
+        if ((bHwFull == true) || (bHwNew == true) || (bGpsFull == true) || (bGpsNew == true))
+        {
+            this->showCompletenessSummary ();
+        }
+    }
 
+    if (this->pclIngest != NULL)
+    {
+        ui->statusBar->showMessage (QString ("reading log messages ... %1 messages read").arg (this->pclIngest->stats ().iNumRecords));
+
+        // the store grows in place while loading, hence the fleet only processes the rows appended since the last refresh
+        if (this->qstrStation.isEmpty () == false)
+        {
+            this->updateFleet (this->qstrStation, this->clTelemetry);
+        }
     }
 }
 
 
-void MainWindow::on_pbReadFromMeasDoc_clicked (void)
+bool MainWindow::startIngest (MessageSource* pclSource, const QString& qstrStationName)
 {
-    int iCounter;
-    QFile qfMeasDoc;
-    QString qstrMeasDocName;
-    QString qstrMeasDoc;
-    QString qstrTemp1;
-    QString qstrTemp2;
-    QDomDocument qddXml;
-    QDomNodeList qdlNodes1;
-    QDomNodeList qdlNodes2;
-    QDomNodeList qdlNodes3;
+    // declaration of variables
+    time_t tStartTime;
+    time_t tStopTime;
+
+    // a load, that is still running, is replaced
+    delete (this->pclIngest);
 
-    qstrMeasDocName = QFileDialog::getOpenFileName (this, "Open MeasDoc XML", "", "*.xml (*.xml)");
-    qfMeasDoc.setFileName(qstrMeasDocName);
-    if (qfMeasDoc.open(QIODevice::ReadOnly) == false)
+    tStartTime = QDateTime (this->ui->startDate->date ()).toSecsSinceEpoch ();
+    tStopTime  = QDateTime (this->ui->stopDate->date  ()).toSecsSinceEpoch ();
+
+    // new telemetry is shown while loading, merged telemetry after the merge
+    this->bIngestMerge = (ui->cbMergeSources->isChecked () == true) && (this->clTelemetry.components ().isEmpty () == false);
+    this->clIngest.clear ();
+    if (this->bIngestMerge == false)
+    {
+        this->clTelemetry.clear ();
+        this->qstrStation = qstrStationName;
+    }
+
+    this->pclIngest = new IngestPipeline (pclSource, tStartTime, tStopTime, this);
+    connect (this->pclIngest, SIGNAL (recordsAvailable ()), this, SLOT (ingestRecordsAvailable ()));
+    connect (this->pclIngest, SIGNAL (finished ()),         this, SLOT (ingestFinished ()));
+
+    ui->statusBar->showMessage ("reading log messages ...");
+
+    return (this->pclIngest->start ());
+}
+
+
+void MainWindow::ingestRecordsAvailable (void)
+{
+    // declaration of variables
+    QVector<sLogRecord_t> qvecRecords;
+    TelemetryStore&       clTarget = (this->bIngestMerge == true) ? this->clIngest : this->clTelemetry;
+    PhaseTimer            clTimer ("ingest_append");
+
+    if ((this->pclIngest == NULL) || (this->pclIngest->takeRecords (qvecRecords) <= 0))
+    {
+        return;
+    }
+
+    for (const sLogRecord_t& sRecord : qvecRecords)
+    {
+        clTarget.appendRecord (sRecord);
+    }
+
+    // the records are appended at once, the plots follow at the refresh rate
+    if ((this->bIngestMerge == false) && (this->clRefreshTimer.isActive () == false))
+    {
+        this->clRefreshTimer.start ();
+    }
+}
+
+
+void MainWindow::ingestFinished (void)
+{
+    // declaration of variables
+    QString       qstrStationName;
+    sMergeStats_t sStats;
+
+    // a queued notification of a replaced pipeline is ignored
+    if ((this->pclIngest == NULL) || (this->pclIngest->isFinished () == false))
+    {
+        return;
+    }
+
+    this->pclIngest->wait ();
+    this->ingestRecordsAvailable ();
+    this->clRefreshTimer.stop ();
+
+    sStats          = this->pclIngest->stats ();
+    qstrStationName = this->pclIngest->stationName ();
+    if (this->pclIngest->errorString ().isEmpty () == false)
+    {
+        QMessageBox::warning(this, "Unable to read Log", "Unable to read log messages!\n" + this->pclIngest->errorString ());
+    }
+
+    this->pclIngest->deleteLater ();
+    this->pclIngest = NULL;
+
+    // the store is rebuilt in time order, if the source was not ordered
+    if ((this->bIngestMerge == true) || (sStats.iNumOutOfOrder > 0))
+    {
+        TelemetryStore    clLoaded = (this->bIngestMerge == true) ? this->clIngest : this->clTelemetry;
+        StoreRecordSource clSource (clLoaded, true);
+
+        this->clIngest.clear ();
+        this->loadSources (QVector<RecordSource*> () << &clSource, qstrStationName, this->bIngestMerge);
+        return;
+    }
+
+    if (this->qstrStation.isEmpty () == true)
+    {
+        this->qstrStation = qstrStationName;
+    }
+
+    this->showTelemetry ();
+    this->updateFleet   (this->qstrStation, this->clTelemetry);
+    this->showMergeStats (sStats);
+}
+
+
+void MainWindow::on_pbFleetView_clicked (void)
+{
+    if (this->pclFleetView == NULL)
+    {
+        this->pclFleetView = new FleetView (this);
+        this->pclFleetView->showFleet (this->clFleet);
+    }
+
+    this->pclFleetView->show ();
+    this->pclFleetView->raise ();
+    this->pclFleetView->activateWindow ();
+}
+
+
+void MainWindow::on_pbDiagnostics_clicked (void)
+{
+    if (this->pclPhaseView == NULL)
     {
-        QMessageBox::warning(this, "Unable to open MeasDoc XML", "Unable to open MeasDoc XML file!");
+        this->pclPhaseView = new PhaseView (this);
+    }
+
+    this->pclPhaseView->showPhases ();
+    this->pclPhaseView->show ();
+    this->pclPhaseView->raise ();
+    this->pclPhaseView->activateWindow ();
+}
+
+
+bool MainWindow::updateFleet (const QString& qstrStationName, const TelemetryStore& clStore)
+{
+    // declaration of variables
+    sStationSummary_t sSummary;
+    bool              bRetValue;
+
+    // only the rows, that are new since the last poll of this station, are processed
+    bRetValue = this->clFleet.update (qstrStationName, clStore);
+
+    if ((bRetValue == true) && (this->pclFleetView != NULL) && (this->clFleet.summary (qstrStationName, sSummary) == true))
+    {
+        this->pclFleetView->updateStation (sSummary);
+    }
+
+    return (bRetValue);
+}
+
+
+bool MainWindow::updatePlotOrigin (void)
+{
+    // declaration of variables
+    qint64 tLast;
+
+    // all plots share the first timestamp of all components as origin, hence the
+    // tabs can be compared directly
+    return (this->clTelemetry.timeRange (this->tPlotOrigin, tLast));
+}
+
+
+bool MainWindow::plotHwStatusGraphs (const TelemetrySeries& clSeries)
+{
+    bool            bRetValue = true;
+    int             iCounter;
+    int             iTier;
+    qint64          tFirst;
+    qint64          tLast;
+    bool            bHasRows;
+    const QVector<qint64>& qvecTimeStamps = clSeries.timeStamps ();
+    PhaseTimer             clTimer ("plot_hw");
+
+    QPen clPen = QPen (QColor (0, 0, 255, 80));
+    clPen.setWidth (1);
+
+    this->bPlotUpdating = true;
+
+    // the gaps are drawn as breaks of the lines
+    GapDetector::detect (qvecTimeStamps, C_LOG_GAP_FACTOR, this->sHwCompleteness);
+
+    // only the rows, that are new since the last call, are checked
+    this->clAnomalies.update (clSeries);
+
+    // the bounds are kept by the series, the column is not scanned
+    bHasRows = clSeries.timeRange (tFirst, tLast);
+
+    for (sPlotBinding_t& sBinding : this->qvecHwPlots)
+    {
+        // the overview binds to the finest resolution, that still fits into the plot
+        iTier = -1;
+        if (bHasRows == true)
+        {
+            iTier = clSeries.selectTier (tFirst, tLast, this->getPlotMaxPoints (sBinding.pclPlot));
+        }
+
+        // the data is bound below, hence the plot is only replotted once
+        this->setupPlot (sBinding.pclPlot,
+                         sBinding.qstrHeading,
+                         "Time Since Start [days]",
+                         sBinding.qstrHeading);
+
+        // min / max envelope of the downsampled tiers
+        for (iCounter = 0; iCounter < 2; iCounter++)
+        {
+            sBinding.pclPlot->addGraph ();
+            sBinding.pclPlot->graph    (iCounter + 1)->setPen (clPen);
+            sBinding.pclPlot->graph    (iCounter + 1)->removeFromLegend ();
+        }
+        sBinding.pclPlot->graph (2)->setChannelFillGraph (sBinding.pclPlot->graph (1));
+        sBinding.pclPlot->graph (2)->setBrush (QColor (0, 0, 255, 40));
+
+        this->bindPlotData      (sBinding, clSeries, iTier);
+        this->addAnomalyMarkers (sBinding, clSeries);
+
+        sBinding.pclPlot->rescaleAxes ();
+        this->setPlotProgress (sBinding.pclPlot, clSeries, sBinding.sProgress);
+        {
+            PhaseTimer clReplotTimer ("replot");
+            sBinding.pclPlot->replot ();
+        }
+    }
+
+    this->bPlotUpdating = false;
+
+    return (bRetValue);
+}
+
+
+bool MainWindow::showEnergySummary (const TelemetrySeries& clSeries)
+{
+    bool             bRetValue = true;
+    QString          qstrMessage;
+    sEnergySummary_t sSummary;
+
+    // only the rows, that are new since the last call, are processed
+    this->clEnergy.update (clSeries);
+    sSummary = this->clEnergy.summary ();
+
+    qstrMessage = QString ("Energy: %1 Wh (gaps: %2 h, est. %3 Wh) | Mean Power: %4 W | Battery: %5 V, %6 V/h")
+                  .arg (sSummary.dEnergyWh,                              0, 'f', 1)
+                  .arg ((double) sSummary.lliGapSeconds / 3600.0,        0, 'f', 1)
+                  .arg (sSummary.dGapEnergyWh,                           0, 'f', 1)
+                  .arg (sSummary.dMeanPowerW,                            0, 'f', 2)
+                  .arg (sSummary.dVoltage,                               0, 'f', 2)
+                  .arg (sSummary.dVoltageSlope,                          0, 'f', 3);
+
+    if (sSummary.dRemainingHours >= 0.0)
+    {
+        qstrMessage += QString (" | Remaining Runtime: %1 h (empty at %2)")
+                       .arg (sSummary.dRemainingHours, 0, 'f', 1)
+                       .arg (QDateTime::fromSecsSinceEpoch (sSummary.tEmptyTime).toString ("yyyy-MM-dd hh:mm"));
     }
     else
     {
-        qstrMeasDoc.clear ();
-        qstrMeasDoc = qfMeasDoc.readAll();
+        qstrMessage += " | Battery not discharging";
+    }
 
-        qddXml.clear();
-        qddXml.setContent(qstrMeasDoc);
-        qdlNodes1 = qddXml.elementsByTagName("message");
+    this->pclEnergyLabel->setText (qstrMessage);
 
-        this->qvecGPStatus.clear();
-        this->qvecHWStatus.clear();
-        for (iCounter = 0; iCounter < qdlNodes1.size(); iCounter++)
+    return (bRetValue);
+}
+
+
+bool MainWindow::showCompletenessSummary (void)
+{
+    bool    bRetValue = true;
+    QString qstrMessage;
+
+    const sCompletenessReport_t* apsReports [2] = {&this->sHwCompleteness, &this->sGpsCompleteness};
+    const char*                  apcNames   [2] = {HWStatusTable::pcComponent, GPStatusTable::pcComponent};
+
+    for (int iCounter = 0; iCounter < 2; iCounter++)
+    {
+        if (iCounter > 0)
         {
-            qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("component");
-            if (qdlNodes2.size() > 0)
-            {
-                if (qdlNodes2.at(0).firstChild().nodeValue().contains("HW_STATUS"))
-                {
-                    sHWStatus_t sMsg;
-
-                    // timestamp
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("date");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp1 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("time");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp2 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    qstrTemp1 += " " + qstrTemp2;
-                    sMsg.sTimeStamp = QDateTime::fromString(qstrTemp1, "yyyy-MM-dd hh:mm:ss").toUTC().toTime_t();
-
-                    // battery voltage
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("batt_volt");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp1 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    sMsg.dBattVoltage = qstrTemp1.toDouble() / 10.0;
-
-                    // temperatrue
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("temp");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp1 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    sMsg.dTemperatureSystem = qstrTemp1.toDouble();
-
-                    // temperatrue
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("temp_sensor");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp1 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    sMsg.dTemperatureSensor = qstrTemp1.toDouble();
-
-                    // battery current 1
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("batt1_curr");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp1 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    sMsg.dBattCurr1 = qstrTemp1.toDouble() / 100.0;
-
-                    // battery current 2
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("batt2_curr");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp1 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    sMsg.dBattCurr2 = qstrTemp1.toDouble() / 100.0;
-
-                    this->qvecHWStatus.push_back(sMsg);
-                }
-                else if (qdlNodes2.at(0).firstChild().nodeValue().contains("GPS_STATUS"))
-                {
-                    sGPStatus_t sMsg;
-
-                    // timestamp
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("date");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp1 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("time");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp2 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    qstrTemp1 += " " + qstrTemp2;
-                    sMsg.sTimeStamp = QDateTime::fromString(qstrTemp1, "yyyy-MM-dd hh:mm:ss").toUTC().toTime_t();
-
-                    // number of satellites
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("num_sats");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp1 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    sMsg.dNumSats = qstrTemp1.toDouble();
-
-                    // sync status
-                    qdlNodes2 = qdlNodes1.at(iCounter).toElement().elementsByTagName("sync_state");
-                    if (qdlNodes2.size() > 0)
-                    {
-                        qstrTemp1 = qdlNodes2.at(0).firstChild().nodeValue();
-                    }
-                    sMsg.dSyncState = qstrTemp1.toDouble();
-
-                    this->qvecGPStatus.push_back(sMsg);
-                }
-            }
+            qstrMessage += " | ";
         }
 
-        this->plotHwStatusGraphs (this->qvecHWStatus);
-        this->plotGPSStatusGraphs(this->qvecGPStatus);
+        qstrMessage += QString ("%1: %2 % complete, %3 gaps (%4 h), period %5 s")
+                       .arg (apcNames [iCounter])
+                       .arg (apsReports [iCounter]->dCompleteness * 100.0, 0, 'f', 1)
+                       .arg (apsReports [iCounter]->qvecGaps.size ())
+                       .arg ((double) apsReports [iCounter]->lliGapSeconds / 3600.0, 0, 'f', 1)
+                       .arg (apsReports [iCounter]->lliNominalPeriod);
     }
+
+    this->pclCompletenessLabel->setText (qstrMessage);
+
+    return (bRetValue);
+}
+
+
+bool MainWindow::showMergeStats (const sMergeStats_t& sStats)
+{
+    // the statistics of the last load are kept next to the completeness and the energy summary
+    this->pclMergeLabel->setText (QString ("%1 messages read, %2 duplicates removed, %3 out of time order")
+                                  .arg (sStats.iNumRecords)
+                                  .arg (sStats.iNumDuplicates)
+                                  .arg (sStats.iNumOutOfOrder));
+
+    return (true);
+}
+
+
+bool MainWindow::addAnomalyMarkers (sPlotBinding_t& sBinding, const TelemetrySeries& clSeries)
+{
+    bool bRetValue;
+
+    sBinding.pclPlot->addGraph ();
+    sBinding.pclPlot->graph    (sBinding.pclPlot->graphCount () - 1)->setName         ("Anomalies");
+    sBinding.pclPlot->graph    (sBinding.pclPlot->graphCount () - 1)->setLineStyle    (QCPGraph::lsNone);
+    sBinding.pclPlot->graph    (sBinding.pclPlot->graphCount () - 1)->setScatterStyle (QCPScatterStyle (QCPScatterStyle::ssCircle, QPen (Qt::red, 2), Qt::NoBrush, 9));
+
+    bRetValue = this->setAnomalyMarkers (sBinding, clSeries);
+
+    return (bRetValue);
 }
 
 
-bool MainWindow::plotHwStatusGraphs (QVector<sHWStatus_t> qvecHWStatus)
+bool MainWindow::setAnomalyMarkers (sPlotBinding_t& sBinding, const TelemetrySeries& clSeries)
 {
     bool            bRetValue = true;
-    int             iCounter;
     QVector<double> qvecXAxis;
     QVector<double> qvecYAxis;
-    unsigned int    uiTemp;
+    const QVector<double>& qvecPower = this->clDerived.column (clSeries, "power");
 
-    QPen clPen = QPen (Qt::blue);
-    clPen.setWidth (3);
+    for (const sAnomalyEvent_t& sEvent : this->clAnomalies.events ())
+    {
+        if (sEvent.qstrChannel == sBinding.qstrChannel)
+        {
+            qvecXAxis.push_back ((sEvent.tTimeStamp - this->tPlotOrigin) / 86400.0);
+            qvecYAxis.push_back (sEvent.dValue);
+        }
+        else if ((sBinding.qstrChannel == "power") &&
+                 ((sEvent.qstrChannel == "batt1_curr") || (sEvent.qstrChannel == "batt2_curr")) &&
+                 (sEvent.iRow < qvecPower.size ()))
+        {
+            // current spikes are shown on the power consumption
+            qvecXAxis.push_back ((sEvent.tTimeStamp - this->tPlotOrigin) / 86400.0);
+            qvecYAxis.push_back (qvecPower [sEvent.iRow]);
+        }
+    }
 
-    // get time values
-    qvecXAxis.clear();
-    for (iCounter = 0; iCounter < qvecHWStatus.size(); iCounter++)
+    // the markers are the last graph of the plot
+    sBinding.pclPlot->graph (sBinding.pclPlot->graphCount () - 1)->setData (qvecXAxis, qvecYAxis);
+
+    return (bRetValue);
+}
+
+
+void MainWindow::hwPlotRangeChanged (const QCPRange& clRange)
+{
+    int                    iTier;
+    qint64                 tStart;
+    qint64                 tStop;
+    const TelemetrySeries& clSeries = this->clTelemetry.series (HWStatusTable::pcComponent);
+
+    if (this->bPlotUpdating == true)
     {
-        uiTemp = qvecHWStatus [iCounter].sTimeStamp - qvecHWStatus [0].sTimeStamp;
-        qvecXAxis.push_back(uiTemp / 86400.0);
+        return;
+    }
+
+    tStart = this->tPlotOrigin + (qint64) std::floor (clRange.lower * 86400.0);
+    tStop  = this->tPlotOrigin + (qint64) std::ceil  (clRange.upper * 86400.0);
+
+    for (sPlotBinding_t& sBinding : this->qvecHwPlots)
+    {
+        if (sBinding.pclPlot->xAxis == this->sender ())
+        {
+            // only rebind, if the zoom level requires another resolution
+            iTier = clSeries.selectTier (tStart, tStop, this->getPlotMaxPoints (sBinding.pclPlot));
+            if (iTier != sBinding.iTier)
+            {
+                this->bPlotUpdating = true;
+                this->bindPlotData (sBinding, clSeries, iTier);
+                sBinding.pclPlot->replot ();
+                this->bPlotUpdating = false;
+            }
+        }
     }
+}
+
+
+bool MainWindow::getPlotData (const TelemetrySeries& clSeries, const QString& qstrChannel, const int iTier,
+                              QVector<double>& qvecXAxis, QVector<double>& qvecMean, QVector<double>& qvecMin, QVector<double>& qvecMax)
+{
+    bool bRetValue = true;
+    int  iCounter;
+
+    qvecXAxis.clear ();
+    qvecMean.clear  ();
+    qvecMin.clear   ();
+    qvecMax.clear   ();
 
-    // plot system temperarure
-    qvecYAxis.clear();
-    for (iCounter = 0; iCounter < qvecHWStatus.size(); iCounter++)
+    if (iTier < 0)
     {
-        qvecYAxis.push_back(qvecHWStatus [iCounter].dTemperatureSystem);
+        // raw data
+        const QVector<qint64>& qvecTimeStamps = clSeries.timeStamps ();
+
+        qvecXAxis.reserve (qvecTimeStamps.size ());
+        for (iCounter = 0; iCounter < qvecTimeStamps.size(); iCounter++)
+        {
+            qvecXAxis.push_back((qvecTimeStamps [iCounter] - this->tPlotOrigin) / 86400.0);
+        }
+
+        if (clSeries.channelIndex (qstrChannel) >= 0)
+        {
+            qvecMean = clSeries.column (qstrChannel);
+        }
+        else
+        {
+            qvecMean = this->clDerived.column (clSeries, qstrChannel);
+        }
+    }
+    else
+    {
+        // downsampled tier, derived channels have their own tiers with one channel
+        const TelemetryTier* pclTier  = &clSeries.tier (iTier);
+        int                  iChannel = clSeries.channelIndex (qstrChannel);
+
+        if (iChannel < 0)
+        {
+            pclTier  = &this->clDerived.tier (clSeries, qstrChannel, iTier);
+            iChannel = 0;
+        }
+
+        // the points are located at the center of the buckets
+        const QVector<qint64>& qvecBuckets = pclTier->timeStamps ();
+
+        qvecXAxis.reserve (qvecBuckets.size ());
+        for (iCounter = 0; iCounter < qvecBuckets.size(); iCounter++)
+        {
+            qvecXAxis.push_back(((qvecBuckets [iCounter] - this->tPlotOrigin) + (pclTier->bucketSeconds () / 2.0)) / 86400.0);
+        }
+
+        qvecMean = pclTier->mean    (iChannel);
+        qvecMin  = pclTier->minimum (iChannel);
+        qvecMax  = pclTier->maximum (iChannel);
     }
-    this->drawPlot(ui->plotTemperature,
-                   "System Temperature [degree C]",
-                   "Time Since Start [days]",
-                   "System Temperature [degree C]",
-                   qvecXAxis, qvecYAxis);
 
-    // plot sensor temperarure
-    qvecYAxis.clear();
-    for (iCounter = 0; iCounter < qvecHWStatus.size(); iCounter++)
+    if (qvecMean.size () != qvecXAxis.size ())
     {
-        qvecYAxis.push_back(qvecHWStatus [iCounter].dTemperatureSensor);
+        qvecXAxis.resize (qMin (qvecXAxis.size (), qvecMean.size ()));
+        qvecMean.resize  (qvecXAxis.size ());
+        bRetValue = false;
     }
-    this->drawPlot(ui->plotTemperatureSensor,
-                   "Sensor Temperature [degree C]",
-                   "Time Since Start [days]",
-                   "Sensor Temperature [degree C]",
-                   qvecXAxis, qvecYAxis);
 
-    // plot battery voltage
-    qvecYAxis.clear();
-    for (iCounter = 0; iCounter < qvecHWStatus.size(); iCounter++)
+    return (bRetValue);
+}
+
+
+bool MainWindow::bindPlotData (sPlotBinding_t& sBinding, const TelemetrySeries& clSeries, const int iTier)
+{
+    bool            bRetValue = true;
+    QVector<double> qvecXAxis;
+    QVector<double> qvecMean;
+    QVector<double> qvecMin;
+    QVector<double> qvecMax;
+    QVector<int>    qvecBreaks;
+    double          dMaxDelta;
+
+    bRetValue = this->getPlotData (clSeries, sBinding.qstrChannel, iTier, qvecXAxis, qvecMean, qvecMin, qvecMax);
+
+    // interrupt the lines at logging gaps, empty buckets of the tiers are no gaps
+    if (this->sHwCompleteness.lliGapThreshold > 0)
     {
-        qvecYAxis.push_back(qvecHWStatus [iCounter].dBattVoltage);
+        dMaxDelta = this->sHwCompleteness.lliGapThreshold;
+        if (iTier >= 0)
+        {
+            dMaxDelta = qMax (dMaxDelta, 1.5 * TelemetrySeries::alliTierSeconds [iTier]);
+        }
+
+        qvecBreaks = GapDetector::findBreaks (qvecXAxis, dMaxDelta / 86400.0);
+        if (qvecMin.size () == qvecXAxis.size ())
+        {
+            GapDetector::insertBreaks (qvecMin, qvecBreaks, false);
+            GapDetector::insertBreaks (qvecMax, qvecBreaks, false);
+        }
+        GapDetector::insertBreaks (qvecMean,  qvecBreaks, false);
+        GapDetector::insertBreaks (qvecXAxis, qvecBreaks, true);
     }
-    this->drawPlot(ui->plotBatteryVoltage,
-                   "Battery Voltage [V]",
-                   "Time Since Start [days]",
-                   "Battery Voltage [V]",
-                   qvecXAxis, qvecYAxis);
 
-    // plot power consumption
-    qvecYAxis.clear();
-    for (iCounter = 0; iCounter < qvecHWStatus.size(); iCounter++)
+    sBinding.pclPlot->graph (0)->setData (qvecXAxis, qvecMean);
+    if (sBinding.pclPlot->graphCount () >= 3)
     {
-        qvecYAxis.push_back(qvecHWStatus [iCounter].dBattCurr1);
-        qvecYAxis.back() += qvecHWStatus [iCounter].dBattCurr2;
-        qvecYAxis.back() *= qvecHWStatus [iCounter].dBattVoltage;
+        if (qvecMin.size () == qvecXAxis.size ())
+        {
+            sBinding.pclPlot->graph (1)->setData (qvecXAxis, qvecMin);
+            sBinding.pclPlot->graph (2)->setData (qvecXAxis, qvecMax);
+        }
+        else
+        {
+            sBinding.pclPlot->graph (1)->clearData ();
+            sBinding.pclPlot->graph (2)->clearData ();
+        }
     }
-    this->drawPlot(ui->plotPowerConsumption,
-                   "Power Consumption [W]",
-                   "Time Since Start [days]",
-                   "Power Consumption [W]",
-                   qvecXAxis, qvecYAxis);
+
+    sBinding.iTier                 = iTier;
+    sBinding.sProgress.uiContentId = clSeries.contentId ();
+    sBinding.sProgress.iNumRows    = clSeries.size ();
 
     return (bRetValue);
 }
 
 
-bool MainWindow::plotGPSStatusGraphs (QVector<sGPStatus_t> qvecGPStatus)
+int MainWindow::getPlotMaxPoints (const QCustomPlot* pclPlot) const
+{
+    // 2 points per pixel column, at least 500 points
+    return (qMax (2 * pclPlot->axisRect ()->width (), 500));
+}
+
+
+bool MainWindow::plotGPSStatusGraphs (const TelemetrySeries& clSeries)
 {
     bool            bRetValue = true;
     int             iCounter;
     QVector<double> qvecXAxis;
-    QVector<double> qvecYAxis1;
-    QVector<double> qvecYAxis2;
-    unsigned int    uiTemp;
+    const QVector<qint64>& qvecTimeStamps = clSeries.timeStamps ();
+    QVector<double>        qvecYAxis1     = clSeries.column ("num_sats");
+    QVector<double>        qvecYAxis2     = clSeries.column ("sync_state");
+    QVector<int>           qvecBreaks;
+    PhaseTimer             clTimer ("plot_gps");
 
     QPen clPen = QPen (Qt::blue);
     clPen.setWidth (3);
 
     // get time values
     qvecXAxis.clear();
-    for (iCounter = 0; iCounter < qvecGPStatus.size(); iCounter++)
+    for (iCounter = 0; iCounter < qvecTimeStamps.size(); iCounter++)
     {
-        uiTemp = qvecGPStatus [iCounter].sTimeStamp - qvecGPStatus [0].sTimeStamp;
-        qvecXAxis.push_back(uiTemp / 86400.0);
+        qvecXAxis.push_back((qvecTimeStamps [iCounter] - this->tPlotOrigin) / 86400.0);
     }
 
-    qvecYAxis1.clear();
-    for (iCounter = 0; iCounter < qvecGPStatus.size(); iCounter++)
+    // interrupt the lines at logging gaps
+    if (GapDetector::detect (qvecTimeStamps, C_LOG_GAP_FACTOR, this->sGpsCompleteness) == true)
     {
-        qvecYAxis1.push_back(qvecGPStatus [iCounter].dNumSats);
-        qvecYAxis2.push_back(qvecGPStatus [iCounter].dSyncState);
+        qvecBreaks = GapDetector::findBreaks (qvecXAxis, this->sGpsCompleteness.lliGapThreshold / 86400.0);
+        GapDetector::insertBreaks (qvecYAxis1, qvecBreaks, false);
+        GapDetector::insertBreaks (qvecYAxis2, qvecBreaks, false);
+        GapDetector::insertBreaks (qvecXAxis,  qvecBreaks, true);
     }
 
     ui->plotGPS->clearGraphs ();
@@ -455,30 +981,257 @@ bool MainWindow::plotGPSStatusGraphs (QVector<sGPStatus_t> qvecGPStatus)
     ui->plotGPS->setInteractions  (QCP::iRangeDrag | QCP::iRangeZoom);
     ui->plotGPS->xAxis->rescale();
 
-    ui->plotGPS->repaint     ();
-    ui->plotGPS->replot      ();
+    // shade sync loss and low satellite intervals, the intervals are only extended by new rows
+    this->clSyncIntervals.update (clSeries);
+    this->clSatsIntervals.update (clSeries);
+    ui->plotGPS->clearItems ();
+    if (qvecTimeStamps.isEmpty () == false)
+    {
+        this->addIntervalSpans (ui->plotGPS, this->clSyncIntervals.intervalsBelow (C_GPS_SYNC_STATE_SYNCED), this->tPlotOrigin, QColor (255,   0, 0, 50));
+        this->addIntervalSpans (ui->plotGPS, this->clSatsIntervals.intervalsBelow (C_GPS_MIN_SATELLITES),    this->tPlotOrigin, QColor (255, 165, 0, 50));
+    }
+
+    this->setPlotProgress (ui->plotGPS, clSeries, this->sGpsProgress);
+
+    {
+        PhaseTimer clReplotTimer ("replot");
+        ui->plotGPS->repaint     ();
+        ui->plotGPS->replot      ();
+    }
 
     return (bRetValue);
 }
 
 
-bool MainWindow::drawPlot (QCustomPlot* pclPlot, const QString qstrHeading, const QString qstrXAxis, const QString qstrYAxis, QVector<double> qvecXAxis, QVector<double> qvecYAxis)
+bool MainWindow::appendHwStatusGraphs (const TelemetrySeries& clSeries)
 {
     bool            bRetValue = true;
-    int             iCounter;
+    QVector<double> qvecXAxis;
+    QVector<double> qvecYAxis;
+    double          dMaxDelta;
+    int             iTier;
+    qint64          tStart;
+    qint64          tStop;
+    PhaseTimer      clTimer ("append_hw");
+
+    this->bPlotUpdating = true;
+
+    // only the rows, that are new since the last call, are checked for gaps and anomalies
+    GapDetector::append (clSeries.timeStamps (), C_LOG_GAP_FACTOR, this->sHwCompleteness);
+    this->clAnomalies.update (clSeries);
+    dMaxDelta = this->sHwCompleteness.lliGapThreshold / 86400.0;
+
+    for (sPlotBinding_t& sBinding : this->qvecHwPlots)
+    {
+        // the new raw rows extend the bounds of raw and tier bindings, the tiers keep min / max of the rows
+        this->getPlotRows (clSeries, sBinding.qstrChannel, sBinding.sProgress.iNumRows, dMaxDelta, qvecXAxis, qvecYAxis);
+        if (sBinding.iTier < 0)
+        {
+            sBinding.pclPlot->graph (0)->addData (qvecXAxis, qvecYAxis);
+        }
+        this->extendPlotBounds (sBinding.pclPlot, qvecXAxis, qvecYAxis, sBinding.sProgress);
+        sBinding.sProgress.iNumRows = clSeries.size ();
+
+        // the visible range may hold too many rows by now, hence the resolution is selected again
+        tStart = this->tPlotOrigin + (qint64) std::floor (sBinding.pclPlot->xAxis->range ().lower * 86400.0);
+        tStop  = this->tPlotOrigin + (qint64) std::ceil  (sBinding.pclPlot->xAxis->range ().upper * 86400.0);
+        iTier  = clSeries.selectTier (tStart, tStop, this->getPlotMaxPoints (sBinding.pclPlot));
+        if ((iTier >= 0) || (sBinding.iTier >= 0))
+        {
+            // the tiers are small, they are bound again
+            this->bindPlotData (sBinding, clSeries, iTier);
+
+            // the points of the tiers are located at the center of the buckets, behind the latest row
+            if ((iTier >= 0) && (sBinding.pclPlot->graph (0)->data ()->isEmpty () == false))
+            {
+                qvecXAxis.fill (sBinding.pclPlot->graph (0)->data ()->lastKey (),       1);
+                qvecYAxis.fill (sBinding.pclPlot->graph (0)->data ()->last  ().value, 1);
+                this->extendPlotBounds (sBinding.pclPlot, qvecXAxis, qvecYAxis, sBinding.sProgress);
+            }
+        }
+
+        this->setAnomalyMarkers (sBinding, clSeries);
+        {
+            PhaseTimer clReplotTimer ("replot");
+            sBinding.pclPlot->replot ();
+        }
+    }
+
+    this->bPlotUpdating = false;
+
+    return (bRetValue);
+}
+
+
+bool MainWindow::appendGPSStatusGraphs (const TelemetrySeries& clSeries)
+{
+    bool            bRetValue = true;
+    QVector<double> qvecXAxis1;
+    QVector<double> qvecXAxis2;
+    QVector<double> qvecYAxis1;
+    QVector<double> qvecYAxis2;
+    double          dMaxDelta = 0.0;
+    PhaseTimer      clTimer ("append_gps");
+
+    if (GapDetector::append (clSeries.timeStamps (), C_LOG_GAP_FACTOR, this->sGpsCompleteness) == true)
+    {
+        dMaxDelta = this->sGpsCompleteness.lliGapThreshold / 86400.0;
+    }
+
+    this->getPlotRows (clSeries, "num_sats",   this->sGpsProgress.iNumRows, dMaxDelta, qvecXAxis1, qvecYAxis1);
+    this->getPlotRows (clSeries, "sync_state", this->sGpsProgress.iNumRows, dMaxDelta, qvecXAxis2, qvecYAxis2);
+
+    ui->plotGPS->graph (0)->addData (qvecXAxis1, qvecYAxis1);
+    ui->plotGPS->graph (1)->addData (qvecXAxis2, qvecYAxis2);
+    this->extendPlotBounds (ui->plotGPS, qvecXAxis1, qvecYAxis1, this->sGpsProgress);
+    this->extendPlotBounds (ui->plotGPS, qvecXAxis2, qvecYAxis2, this->sGpsProgress);
+    this->sGpsProgress.iNumRows = clSeries.size ();
+
+    // the intervals are only extended by the new rows
+    this->clSyncIntervals.update (clSeries);
+    this->clSatsIntervals.update (clSeries);
+    ui->plotGPS->clearItems ();
+    this->addIntervalSpans (ui->plotGPS, this->clSyncIntervals.intervalsBelow (C_GPS_SYNC_STATE_SYNCED), this->tPlotOrigin, QColor (255,   0, 0, 50));
+    this->addIntervalSpans (ui->plotGPS, this->clSatsIntervals.intervalsBelow (C_GPS_MIN_SATELLITES),    this->tPlotOrigin, QColor (255, 165, 0, 50));
+
+    {
+        PhaseTimer clReplotTimer ("replot");
+        ui->plotGPS->replot ();
+    }
+
+    return (bRetValue);
+}
+
+
+bool MainWindow::getPlotRows (const TelemetrySeries& clSeries, const QString& qstrChannel, const int iFirstRow, const double dMaxDelta,
+                              QVector<double>& qvecXAxis, QVector<double>& qvecYAxis)
+{
+    bool         bRetValue = true;
+    int          iCounter;
+    int          iStart;
+    int          iStop;
+    QVector<int> qvecBreaks;
+    const QVector<qint64>& qvecTimeStamps = clSeries.timeStamps ();
+    const QVector<double>& qvecColumn     = (clSeries.channelIndex (qstrChannel) >= 0) ? clSeries.column (qstrChannel) :
+                                                                                        this->clDerived.column (clSeries, qstrChannel);
+
+    qvecXAxis.clear ();
+    qvecYAxis.clear ();
+
+    // the last plotted row is included, hence a gap in front of the new rows is found as well
+    iStart = qMax (iFirstRow - 1, 0);
+    iStop  = qMin (qvecTimeStamps.size (), qvecColumn.size ());
+    for (iCounter = iStart; iCounter < iStop; iCounter++)
+    {
+        qvecXAxis.push_back ((qvecTimeStamps [iCounter] - this->tPlotOrigin) / 86400.0);
+        qvecYAxis.push_back (qvecColumn [iCounter]);
+    }
+
+    if (dMaxDelta > 0.0)
+    {
+        qvecBreaks = GapDetector::findBreaks (qvecXAxis, dMaxDelta);
+        GapDetector::insertBreaks (qvecYAxis, qvecBreaks, false);
+        GapDetector::insertBreaks (qvecXAxis, qvecBreaks, true);
+    }
+
+    if ((iStart < iFirstRow) && (qvecXAxis.isEmpty () == false))
+    {
+        qvecXAxis.remove (0);
+        qvecYAxis.remove (0);
+    }
+
+    return (bRetValue);
+}
+
+
+bool MainWindow::extendPlotBounds (QCustomPlot* pclPlot, const QVector<double>& qvecXAxis, const QVector<double>& qvecYAxis, sPlotProgress_t& sProgress)
+{
+    bool     bRetValue = false;
+    bool     bFullView;
+    int      iCounter;
+    QCPRange clKeyBounds   = sProgress.clKeyBounds;
+    QCPRange clValueBounds = sProgress.clValueBounds;
+
+    // as long as the plot shows the bounds, it has not been zoomed or dragged by the user
+    bFullView = (pclPlot->xAxis->range () == sProgress.clKeyBounds) && (pclPlot->yAxis->range () == sProgress.clValueBounds);
+
+    for (iCounter = 0; iCounter < qMin (qvecXAxis.size (), qvecYAxis.size ()); iCounter++)
+    {
+        if (std::isnan (qvecYAxis [iCounter]) == false)
+        {
+            clKeyBounds.expand   (QCPRange (qvecXAxis [iCounter], qvecXAxis [iCounter]));
+            clValueBounds.expand (QCPRange (qvecYAxis [iCounter], qvecYAxis [iCounter]));
+        }
+    }
+
+    // the axes are only changed, if the bounds have grown
+    if ((clKeyBounds != sProgress.clKeyBounds) || (clValueBounds != sProgress.clValueBounds))
+    {
+        if (bFullView == true)
+        {
+            pclPlot->xAxis->setRange (clKeyBounds);
+            pclPlot->yAxis->setRange (clValueBounds);
+            bRetValue = true;
+        }
+
+        sProgress.clKeyBounds   = clKeyBounds;
+        sProgress.clValueBounds = clValueBounds;
+    }
+
+    return (bRetValue);
+}
+
+
+bool MainWindow::setPlotProgress (QCustomPlot* pclPlot, const TelemetrySeries& clSeries, sPlotProgress_t& sProgress)
+{
+    bool bRetValue = true;
+
+    // after rescaleAxes () the ranges of the axes are the bounds of the data
+    sProgress.uiContentId   = clSeries.contentId ();
+    sProgress.iNumRows      = clSeries.size ();
+    sProgress.clKeyBounds   = pclPlot->xAxis->range ();
+    sProgress.clValueBounds = pclPlot->yAxis->range ();
+
+    return (bRetValue);
+}
+
+
+bool MainWindow::addIntervalSpans (QCustomPlot* pclPlot, const QVector<sStateInterval_t>& qvecIntervals, const qint64 tOrigin, const QColor& clColor)
+{
+    bool         bRetValue = true;
+    QCPItemRect* pclRect;
+
+    for (const sStateInterval_t& sInterval : qvecIntervals)
+    {
+        // the rect is much higher than the value range, it is clipped to the axis rect
+        pclRect = new QCPItemRect (pclPlot);
+        pclPlot->addItem (pclRect);
+        pclRect->topLeft->setCoords     ((sInterval.tStart - tOrigin) / 86400.0,  1.0e9);
+        pclRect->bottomRight->setCoords ((sInterval.tStop  - tOrigin) / 86400.0, -1.0e9);
+        pclRect->setPen        (Qt::NoPen);
+        pclRect->setBrush      (clColor);
+        pclRect->setSelectable (false);
+        pclRect->setLayer      ("background");
+    }
+
+    return (bRetValue);
+}
+
+
+bool MainWindow::setupPlot (QCustomPlot* pclPlot, const QString qstrHeading, const QString qstrXAxis, const QString qstrYAxis)
+{
+    bool            bRetValue = true;
+    PhaseTimer      clTimer ("setup_plot");
 
     QPen clPen = QPen (Qt::blue);
     clPen.setWidth (3);
 
     pclPlot->clearGraphs ();
     pclPlot->addGraph    ();
-    pclPlot->graph       (0)->addData (qvecXAxis, qvecYAxis);
     pclPlot->graph       (0)->setName (qstrYAxis);
     pclPlot->graph       (0)->setVisible (true);
     pclPlot->graph       (0)->setPen   (clPen);
     pclPlot->graph       (0)->setBrush (Qt::NoBrush);
-    pclPlot->graph       (0)->rescaleAxes(true);
-    pclPlot->graph       (0)->rescaleAxes(true);
     pclPlot->graph       (0)->keyAxis   ()->setLabel (qstrXAxis);
     pclPlot->graph       (0)->valueAxis ()->setLabel (qstrYAxis);
     pclPlot->xAxis->setScaleType (QCPAxis::stLinear);
@@ -495,10 +1248,6 @@ bool MainWindow::drawPlot (QCustomPlot* pclPlot, const QString qstrHeading, cons
     pclPlot->setLocale               (QLocale(QLocale::English, QLocale::UnitedKingdom));
 
     pclPlot->setInteractions  (QCP::iRangeDrag | QCP::iRangeZoom);
-    pclPlot->xAxis->rescale();
-
-    pclPlot->repaint     ();
-    pclPlot->replot      ();
 
     return (bRetValue);
 }
@@ -31,31 +31,28 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QLabel>
+#include <QTimer>
+#include <QFutureWatcher>
 
 #include "qcustomplot.h"
+#include "telemetrystore.h"
+#include "derivedchannels.h"
+#include "energyanalytics.h"
+#include "stateintervals.h"
+#include "gapdetector.h"
+#include "anomalydetector.h"
+#include "fleetsummary.h"
+#include "fleetview.h"
+#include "phaseview.h"
+#include "recordmerger.h"
+#include "ingestpipeline.h"
+#include "measdocloader.h"
 
 namespace Ui {
 class MainWindow;
 }
 
-typedef struct
-{
-    double dBattVoltage;
-    double dBattCurr1;
-    double dBattCurr2;
-    double dTemperatureSystem;
-    double dTemperatureSensor;
-    time_t sTimeStamp;
-} sHWStatus_t;
-
-
-typedef struct
-{
-    double dNumSats;
-    double dSyncState;
-    time_t sTimeStamp;
-} sGPStatus_t;
-
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -63,6 +60,15 @@ class MainWindow : public QMainWindow
 private slots:
     void on_pbReadLog_clicked (void);
     void on_pbReadFromMeasDoc_clicked (void);
+    void on_pbReadMeasDocFolder_clicked (void);
+    void on_pbReadSqlDump_clicked (void);
+    void on_pbFleetView_clicked (void);
+    void on_pbDiagnostics_clicked (void);
+    void hwPlotRangeChanged (const QCPRange& clRange);
+    void ingestRecordsAvailable (void);
+    void ingestFinished (void);
+    void measDocsLoaded (void);
+    void refreshTelemetry (void);
 
 public:
     explicit MainWindow(QWidget *parent = 0);
@@ -71,13 +77,126 @@ public:
 private:
     Ui::MainWindow *ui;
 
-    QVector<sHWStatus_t> qvecHWStatus;
-    QVector<sGPStatus_t> qvecGPStatus;
-
-    bool plotHwStatusGraphs  (QVector<sHWStatus_t> qvecHWStatus);
-    bool plotGPSStatusGraphs (QVector<sGPStatus_t> qvecGPStatus);
-
-    bool drawPlot (QCustomPlot* pclPlot, const QString qstrHeading, const QString qstrXAxis, const QString qstrYAxis, QVector<double> qvecXAxis, QVector<double> qvecYAxis);
+    TelemetryStore  clTelemetry;
+    DerivedChannels clDerived;
+    EnergyAnalytics clEnergy;
+    StateIntervals  clSyncIntervals;
+    StateIntervals  clSatsIntervals;
+    AnomalyDetector clAnomalies;
+
+    /**
+     * aggregates of all stations, that have been loaded, and the fleet view.
+     */
+    FleetSummary clFleet;
+    FleetView*   pclFleetView;
+
+    /**
+     * diagnostics dialog with the timings of the load and plot phases.
+     */
+    PhaseView* pclPhaseView;
+
+    /**
+     * name of the loaded station, merged sources keep the name of the first load.
+     */
+    QString qstrStation;
+
+    /**
+     * pipeline of the running load and the records, that are merged, when it has finished.
+     */
+    IngestPipeline* pclIngest;
+    TelemetryStore  clIngest;
+    bool            bIngestMerge;
+
+    /**
+     * MeasDoc files, that are read and decoded in the background, and the decoded files,
+     * that are merged, when the load has finished.
+     */
+    MeasDocLoader                           clMeasDocLoader;
+    QFutureWatcher<int>                     clMeasDocWatcher;
+    QMap<QString, QVector<sMeasDocFile_t> > qmapMeasDocStations;
+    QStringList                             qstrlMeasDocFailed;
+
+    /**
+     * logging gaps and completeness of the HW_STATUS and GPS_STATUS series.
+     */
+    sCompletenessReport_t sHwCompleteness;
+    sCompletenessReport_t sGpsCompleteness;
+    QLabel*               pclCompletenessLabel;
+
+    /**
+     * energy balance and runtime forecast of the loaded station, the message area of
+     * the status bar shows the progress of a load.
+     */
+    QLabel*               pclEnergyLabel;
+
+    /**
+     * messages read, duplicates and out of order messages of the last load.
+     */
+    QLabel*               pclMergeLabel;
+
+    /**
+     * rows of a series, that have been plotted, and the data bounds of the plot. While
+     * loading, the new rows are appended to the graphs and the axes are only changed,
+     * if the bounds grow.
+     */
+    typedef struct
+    {
+        quint64  uiContentId;       ///< content id of the plotted series, 0 = not plotted
+        int      iNumRows;          ///< number of plotted rows
+        QCPRange clKeyBounds;       ///< key range of the plotted data
+        QCPRange clValueBounds;     ///< value range of the plotted data
+    } sPlotProgress_t;
+
+    /**
+     * binding of a plot to a channel of the HW_STATUS series. The plot shows raw data or one
+     * of the downsampled tiers, depending on the visible time range.
+     */
+    typedef struct
+    {
+        QCustomPlot*    pclPlot;        ///< plot widget
+        QString         qstrChannel;    ///< channel name, raw or derived channel
+        QString         qstrHeading;    ///< plot heading and y axis label
+        int             iTier;          ///< bound tier, -1 = raw data
+        sPlotProgress_t sProgress;      ///< plotted rows
+    } sPlotBinding_t;
+
+    QVector<sPlotBinding_t> qvecHwPlots;
+    sPlotProgress_t         sGpsProgress;
+    qint64                  tPlotOrigin;
+    bool                    bPlotUpdating;
+
+    /**
+     * throttles the refresh of the plots, while a load is running.
+     */
+    QTimer clRefreshTimer;
+
+    bool getPlotData (const TelemetrySeries& clSeries, const QString& qstrChannel, const int iTier,
+                      QVector<double>& qvecXAxis, QVector<double>& qvecMean, QVector<double>& qvecMin, QVector<double>& qvecMax);
+    bool bindPlotData (sPlotBinding_t& sBinding, const TelemetrySeries& clSeries, const int iTier);
+    bool addAnomalyMarkers (sPlotBinding_t& sBinding, const TelemetrySeries& clSeries);
+    bool setAnomalyMarkers (sPlotBinding_t& sBinding, const TelemetrySeries& clSeries);
+    bool getPlotRows (const TelemetrySeries& clSeries, const QString& qstrChannel, const int iFirstRow, const double dMaxDelta,
+                      QVector<double>& qvecXAxis, QVector<double>& qvecYAxis);
+    bool extendPlotBounds (QCustomPlot* pclPlot, const QVector<double>& qvecXAxis, const QVector<double>& qvecYAxis, sPlotProgress_t& sProgress);
+    bool setPlotProgress  (QCustomPlot* pclPlot, const TelemetrySeries& clSeries, sPlotProgress_t& sProgress);
+    int  getPlotMaxPoints (const QCustomPlot* pclPlot) const;
+
+    bool loadSources         (const QVector<RecordSource*>& qvecSources, const QString& qstrStationName, const bool bMerge);
+    bool loadMeasDocs        (const QStringList& qstrlMeasDocNames);
+    bool startIngest         (MessageSource* pclSource, const QString& qstrStationName);
+    bool showTelemetry       (void);
+    bool updateFleet         (const QString& qstrStationName, const TelemetryStore& clStore);
+    bool updatePlotOrigin    (void);
+    bool plotHwStatusGraphs  (const TelemetrySeries& clSeries);
+    bool plotGPSStatusGraphs (const TelemetrySeries& clSeries);
+    bool appendHwStatusGraphs  (const TelemetrySeries& clSeries);
+    bool appendGPSStatusGraphs (const TelemetrySeries& clSeries);
+    bool showEnergySummary   (const TelemetrySeries& clSeries);
+    bool showCompletenessSummary (void);
+    bool showMergeStats          (const sMergeStats_t& sStats);
+    bool addIntervalSpans    (QCustomPlot* pclPlot, const QVector<sStateInterval_t>& qvecIntervals, const qint64 tOrigin, const QColor& clColor);
+
+    bool setupPlot (QCustomPlot* pclPlot, const QString qstrHeading, const QString qstrXAxis, const QString qstrYAxis);
 
 };
 
@@ -0,0 +1,205 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file measdocloader.cpp
+ *
+ * \brief contains the implementation of the MeasDocLoader class.
+ *
+ * ---
+ */
+
+
+#include "measdocloader.h"
+#include "recordmerger.h"
+#include "logdecoder.h"
+#include "decompressingdevice.h"
+#include "phasetimer.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFuture>
+#include <QList>
+#include <QSemaphore>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstdio>
+
+
+/**
+ * \brief reads and decodes one MeasDoc file.
+ *
+ * the file is decompressed by the pipeline thread of the device and parsed while it
+ * is read. Only the file reads are limited by the semaphore, parsing and decoding
+ * runs with the full number of pool threads. Each call uses its own decoders.
+ */
+static sMeasDocFile_t parseFile (const QString qstrFileName, QSemaphore* pclIOLimit)
+{
+    // declaration of variables
+    sMeasDocFile_t      sFile;
+    DecompressingDevice clDevice (qstrFileName, pclIOLimit);
+    LogDecoderRegistry  clDecoders;
+    sLogRecord_t        sRecord;
+    bool                bOrdered = true;
+    PhaseTimer          clTimer ("measdoc_parse");
+
+    sFile.qstrFileName = qstrFileName;
+    sFile.bValid       = false;
+
+    if (clDevice.open (QIODevice::ReadOnly) == false)
+    {
+        #ifdef C_MEASDOC_LOADER_DEBUG_MSG
+            printf ("[%s] unable to open %s: %s\n", C_MEASDOC_LOADER_NAME, qstrFileName.toStdString ().c_str (),
+                    clDevice.errorString ().toStdString ().c_str ());
+            fflush (stdout);
+        #endif
+        return (sFile);
+    }
+
+    MeasDocRecordSource clSource (&clDevice, clDecoders);
+
+    while (clSource.next (sRecord) == true)
+    {
+        if ((sFile.qvecRecords.isEmpty () == false) && (sRecord.tTimeStamp < sFile.qvecRecords.last ().tTimeStamp))
+        {
+            bOrdered = false;
+        }
+        sFile.qvecRecords.push_back (sRecord);
+    }
+
+    if (clSource.errorString ().isEmpty () == false)
+    {
+        #ifdef C_MEASDOC_LOADER_DEBUG_MSG
+            printf ("[%s] error in %s: %s\n", C_MEASDOC_LOADER_NAME, qstrFileName.toStdString ().c_str (),
+                    clSource.errorString ().toStdString ().c_str ());
+            fflush (stdout);
+        #endif
+        return (sFile);
+    }
+
+    // MeasDocs are collected per station directory, it is the fallback for the serial number
+    if (clSource.serialNumber (sFile.qstrSerial) == false)
+    {
+        sFile.qstrSerial = QFileInfo (qstrFileName).absoluteDir ().dirName ();
+    }
+
+    // the merge needs every source in time order
+    if (bOrdered == false)
+    {
+        std::stable_sort (sFile.qvecRecords.begin (), sFile.qvecRecords.end (), [] (const sLogRecord_t& sA, const sLogRecord_t& sB)
+        {
+            return (sA.tTimeStamp < sB.tTimeStamp);
+        });
+    }
+
+    sFile.bValid = true;
+
+    return (sFile);
+}
+
+
+MeasDocLoader::MeasDocLoader (const int iMaxOpenFilesValue)
+{
+    this->setMaxOpenFiles (iMaxOpenFilesValue);
+}
+
+
+void MeasDocLoader::setMaxOpenFiles (const int iMaxOpenFilesValue)
+{
+    this->iMaxOpenFiles = qMax (iMaxOpenFilesValue, 1);
+}
+
+
+QStringList MeasDocLoader::findFiles (const QString& qstrDirectory)
+{
+    // declaration of variables
+    QStringList  qstrlFileNames;
+    QDirIterator clIterator (qstrDirectory, QStringList () << "*.xml" << "*.XML" << "*.xml.gz" << "*.xml.zst", QDir::Files, QDirIterator::Subdirectories);
+
+    while (clIterator.hasNext () == true)
+    {
+        qstrlFileNames.append (clIterator.next ());
+    }
+    qstrlFileNames.sort ();
+
+    return (qstrlFileNames);
+}
+
+
+sMeasDocFile_t MeasDocLoader::loadFile (const QString& qstrFileName)
+{
+    return (parseFile (qstrFileName, NULL));
+}
+
+
+int MeasDocLoader::load (const QStringList& qstrlFileNames, QMap<QString, QVector<sMeasDocFile_t> >& qmapStations,
+                         QStringList* pqstrlFailed) const
+{
+    // declaration of variables
+    QSemaphore                        clIOLimit (this->iMaxOpenFiles);
+    QList<QFuture<sMeasDocFile_t> >   qlistFutures;
+    int                               iNumFiles = 0;
+
+    qmapStations.clear ();
+    if (pqstrlFailed != NULL)
+    {
+        pqstrlFailed->clear ();
+    }
+
+    // the pool limits the number of parsing threads, the semaphore the number of open files
+    for (const QString& qstrFileName : qstrlFileNames)
+    {
+        qlistFutures.append (QtConcurrent::run (parseFile, qstrFileName, &clIOLimit));
+    }
+
+    // results are collected in the order of the file names, hence the grouping is deterministic
+    for (QFuture<sMeasDocFile_t>& clFuture : qlistFutures)
+    {
+        const sMeasDocFile_t sFile = clFuture.result ();
+
+        if (sFile.bValid == true)
+        {
+            qmapStations [sFile.qstrSerial].push_back (sFile);
+            iNumFiles++;
+        }
+        else if (pqstrlFailed != NULL)
+        {
+            pqstrlFailed->append (sFile.qstrFileName);
+        }
+    }
+
+    #ifdef C_MEASDOC_LOADER_DEBUG_MSG
+        printf ("[%s] %d of %d files decoded, %d stations\n", C_MEASDOC_LOADER_NAME, iNumFiles, qstrlFileNames.size (), qmapStations.size ());
+        fflush (stdout);
+    #endif
+
+    return (iNumFiles);
+}
@@ -0,0 +1,148 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file measdocloader.h
+ *
+ * \brief contains the defintion of the MeasDocLoader class.
+ *
+ * ---
+ */
+
+
+#ifndef MEASDOCLOADER_H
+#define MEASDOCLOADER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+
+#include "telemetrystore.h"
+
+
+#define C_MEASDOC_LOADER_NAME "MeasDocLoader"
+
+
+/**
+ * decoded contents of one MeasDoc file.
+ */
+typedef struct
+{
+    QString               qstrFileName;     ///< file name
+    QString               qstrSerial;       ///< serial number of the station (directory name, if the MeasDoc has none)
+    QVector<sLogRecord_t> qvecRecords;      ///< decoded log messages in time order
+    bool                  bValid;           ///< true: file could be read and parsed
+} sMeasDocFile_t;
+
+
+/**
+ * \class MeasDocLoader
+ *
+ * \brief Reads and decodes many MeasDoc files in parallel.
+ *
+ * The files may be gzip or zstd compressed, they are decompressed while reading.
+ * Each file is parsed and decoded by a task of the global thread pool (one thread
+ * per core). Reading the files is limited to a few concurrent tasks by a semaphore,
+ * hence a campaign on a slow disk or network share is not read with hundreds of
+ * concurrent requests, while the parsing of files, that have been read, continues.
+ * The decoded files are grouped by the serial number of their station.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class MeasDocLoader
+{
+    private:
+        /**
+         * max. number of files, that are read at the same time.
+         */
+        int iMaxOpenFiles;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const int iMaxOpenFilesValue = max. number of files, that are read at the same time
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        MeasDocLoader (const int iMaxOpenFilesValue = 4);
+
+        /**
+         * \brief Sets the max. number of files, that are read at the same time.
+         *
+         * @param[in] const int iMaxOpenFilesValue = number of files (min. 1)
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void setMaxOpenFiles (const int iMaxOpenFilesValue);
+
+        /**
+         * \brief Returns all MeasDoc XML files (also compressed) inside a directory and its subdirectories.
+         *
+         * @param[in] const QString& qstrDirectory = directory
+         * \return QStringList = file names, sorted
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static QStringList findFiles (const QString& qstrDirectory);
+
+        /**
+         * \brief Reads and decodes a single MeasDoc file.
+         *
+         * @param[in] const QString& qstrFileName = file name
+         * \return sMeasDocFile_t = decoded file, check bValid
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static sMeasDocFile_t loadFile (const QString& qstrFileName);
+
+        /**
+         * \brief Reads and decodes MeasDoc files in parallel and groups them by station.
+         *
+         * @param[in] const QStringList& qstrlFileNames = file names
+         * @param[out] QMap<QString, QVector<sMeasDocFile_t> >& qmapStations = decoded files, key is the serial number
+         * @param[out] QStringList* pqstrlFailed = files, that could not be read or parsed, may be NULL
+         * \return int = number of decoded files
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        int load (const QStringList& qstrlFileNames, QMap<QString, QVector<sMeasDocFile_t> >& qmapStations,
+                  QStringList* pqstrlFailed = NULL) const;
+};
+
+#endif // MEASDOCLOADER_H
@@ -0,0 +1,251 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file numberparser.h
+ *
+ * \brief contains the defintion of the NumberParser class.
+ *
+ * ---
+ */
+
+
+#ifndef NUMBERPARSER_H
+#define NUMBERPARSER_H
+
+#include <QString>
+#include <QStringView>
+
+#include <charconv>
+#include <system_error>
+
+
+/**
+ * maximum length of a number string that is converted without temporary QString.
+ */
+#define C_NUMBER_PARSER_MAX_LEN 64
+
+
+/**
+ * \class NumberParser
+ *
+ * \brief This class contains helper functions to convert node values into numbers.
+ *
+ * The functions convert the text directly from the string view of the node value,
+ * using std::from_chars(). Contrary to QString::toDouble() / QString::toInt()
+ * no temporary strings or byte arrays are created, hence no heap memory is
+ * allocated for the conversion.
+ * The accepted input is the same as for the QString functions in "C" locale:
+ * leading and trailing whitespaces and a leading "+" sign are ignored.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class NumberParser
+{
+    private:
+
+        /**
+         * \brief Copies the trimmed number string into a ASCII buffer.
+         *
+         * Returns false, if the string contains non ASCII characters, is empty
+         * or does not fit into the buffer.
+         *
+         * @param[in] const QStringView qsvText = text to be converted
+         * @param[out] char* pcBuffer = buffer with C_NUMBER_PARSER_MAX_LEN bytes
+         * @param[out] int& iLength = number of characters inside buffer
+         * \return bool = true: OK / false: cannot be converted
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool toAscii (const QStringView qsvText, char* pcBuffer, int& iLength)
+        {
+            // declaration of variables
+            int    iStart = 0;
+            int    iStop  = qsvText.size ();
+            int    iCounter;
+            ushort usChar;
+
+            while ((iStart < iStop) && (qsvText [iStart].isSpace () == true))
+            {
+                iStart++;
+            }
+            while ((iStop > iStart) && (qsvText [iStop - 1].isSpace () == true))
+            {
+                iStop--;
+            }
+
+            // from_chars does not accept a leading "+"
+            if ((iStart < iStop) && (qsvText [iStart] == QLatin1Char ('+')))
+            {
+                iStart++;
+                if ((iStart < iStop) && ((qsvText [iStart] == QLatin1Char ('+')) || (qsvText [iStart] == QLatin1Char ('-'))))
+                {
+                    return (false);
+                }
+            }
+
+            iLength = iStop - iStart;
+            if ((iLength <= 0) || (iLength >= C_NUMBER_PARSER_MAX_LEN))
+            {
+                return (false);
+            }
+
+            for (iCounter = 0; iCounter < iLength; iCounter++)
+            {
+                usChar = qsvText [iStart + iCounter].unicode ();
+                if (usChar > 0x7F)
+                {
+                    return (false);
+                }
+                pcBuffer [iCounter] = (char) usChar;
+            }
+
+            return (true);
+        }
+
+        /**
+         * \brief Runs std::from_chars() on the trimmed text.
+         *
+         * The complete text needs to be consumed, otherwise the conversion fails.
+         *
+         * @param[in] const QStringView qsvText = text to be converted
+         * @param[out] T& tValue = converted value
+         * \return bool = true: OK / false: failed to convert text
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        template <typename T>
+        static bool fromChars (const QStringView qsvText, T& tValue)
+        {
+            // declaration of variables
+            char arcBuffer [C_NUMBER_PARSER_MAX_LEN];
+            int  iLength;
+
+            if (toAscii (qsvText, arcBuffer, iLength) == false)
+            {
+                return (false);
+            }
+
+            std::from_chars_result sResult = std::from_chars (arcBuffer, arcBuffer + iLength, tValue);
+
+            return ((sResult.ec == std::errc ()) && (sResult.ptr == (arcBuffer + iLength)));
+        }
+
+    public:
+
+        /**
+         * \brief Converts the text into a double value.
+         *
+         * Texts that are too long for the internal buffer are converted with
+         * QString::toDouble().
+         *
+         * @param[in] const QStringView qsvText = text to be converted
+         * @param[out] double& dValue = converted value, 0.0 on error
+         * \return bool = true: OK / false: failed to convert text
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool toDouble (const QStringView qsvText, double& dValue)
+        {
+            // declaration of variables
+            bool bRetValue;
+
+            if (qsvText.size () >= C_NUMBER_PARSER_MAX_LEN)
+            {
+                dValue = qsvText.toString ().toDouble (&bRetValue);
+            }
+            else
+            {
+                bRetValue = fromChars (qsvText, dValue);
+            }
+
+            if (bRetValue == false)
+            {
+                dValue = 0.0;
+            }
+
+            return (bRetValue);
+        }
+
+        /**
+         * \brief Converts the text into a int value (base 10).
+         *
+         * ---
+         *
+         * @param[in] const QStringView qsvText = text to be converted
+         * @param[out] int& iValue = converted value, 0 on error
+         * \return bool = true: OK / false: failed to convert text
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool toInt (const QStringView qsvText, int& iValue)
+        {
+            // declaration of variables
+            bool bRetValue = fromChars (qsvText, iValue);
+
+            if (bRetValue == false)
+            {
+                iValue = 0;
+            }
+
+            return (bRetValue);
+        }
+
+        /**
+         * \brief Converts the text into a unsigned int value (base 10).
+         *
+         * ---
+         *
+         * @param[in] const QStringView qsvText = text to be converted
+         * @param[out] unsigned int& uiValue = converted value, 0 on error
+         * \return bool = true: OK / false: failed to convert text
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool toUInt (const QStringView qsvText, unsigned int& uiValue)
+        {
+            // declaration of variables
+            bool bRetValue = fromChars (qsvText, uiValue);
+
+            if (bRetValue == false)
+            {
+                uiValue = 0;
+            }
+
+            return (bRetValue);
+        }
+};
+
+#endif // NUMBERPARSER_H
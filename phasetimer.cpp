@@ -0,0 +1,461 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file phasetimer.cpp
+ *
+ * \brief contains the implementation of the PhaseTimer and PhaseProfiler classes.
+ *
+ * ---
+ */
+
+
+#include "phasetimer.h"
+#include "quantilesketch.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QHash>
+#include <QPair>
+#include <QMap>
+#include <QFile>
+#include <QByteArray>
+
+#include <algorithm>
+#include <memory>
+
+
+/**
+ * accuracy of the percentile sketches.
+ */
+#define C_PHASE_SKETCH_K 64
+
+
+/**
+ * node of the phase tree, the id of a phase is its index in the table of all phases.
+ * Phase 0 is the root, i.e. no enclosing phase.
+ */
+typedef struct
+{
+    quint32 uiParent;       ///< enclosing phase
+    QString qstrName;       ///< name of the phase
+    QString qstrPath;       ///< path of the phase
+    int     iDepth;         ///< number of enclosing phases
+} sPhaseNode_t;
+
+/**
+ * recorded call of a phase.
+ */
+typedef struct
+{
+    quint32 uiPhase;        ///< id of the phase
+    qint64  lliStartNs;     ///< start time [ns]
+    qint64  lliDurationNs;  ///< duration [ns]
+} sPhaseEvent_t;
+
+/**
+ * timings of a phase inside one thread.
+ */
+typedef struct
+{
+    quint64        ullCount;        ///< number of calls
+    qint64         lliTotalNs;      ///< total time [ns]
+    qint64         lliMaxNs;        ///< max. time [ns]
+    QuantileSketch clSketch;        ///< distribution of the times [ms]
+} sPhaseAccu_t;
+
+/**
+ * buffer of a thread. The buffer is shared by the thread and the profiler, hence the
+ * timings are kept, after the thread has finished.
+ */
+typedef struct
+{
+    QMutex                                     clMutex;        ///< locks the timings and events
+    int                                        iThreadId;      ///< number of the thread in the trace
+    QVector<sPhaseAccu_t>                      qvecStats;      ///< timings, indexed by the id of the phase
+    QVector<sPhaseEvent_t>                     qvecEvents;     ///< events for the trace
+    QHash<QPair<quint32, const char*>, quint32> qhashPhases;   ///< ids of the phases, only used by the thread itself
+    quint32                                    uiCurrent;      ///< current phase of the thread
+} sThreadBuffer_t;
+
+/**
+ * state of the profiler, that is shared by all threads.
+ */
+typedef struct
+{
+    QMutex                                      clMutex;        ///< locks the phase table and the list of buffers
+    QElapsedTimer                               clClock;        ///< time base of all events
+    QVector<sPhaseNode_t>                       qvecPhases;     ///< phase tree
+    QHash<QPair<quint32, QString>, quint32>     qhashPhases;    ///< ids of the phases by parent and name
+    QVector<std::shared_ptr<sThreadBuffer_t> >  qvecBuffers;    ///< buffers of all threads
+    std::atomic<int>                            iNumEvents;     ///< number of events of all buffers
+    std::atomic<quint64>                        ullNumDropped;  ///< number of events, that did not fit into the trace
+    int                                         iNextThreadId;  ///< number of the next thread
+} sProfilerState_t;
+
+
+std::atomic<bool> PhaseProfiler::bEnabled (false);
+
+
+/**
+ * \brief creates the state of the profiler.
+ */
+static sProfilerState_t* createProfilerState (void)
+{
+    // declaration of variables
+    sProfilerState_t* psState = new sProfilerState_t ();
+
+    psState->clClock.start ();
+    psState->qvecPhases.push_back ({0, QString (), QString (), -1});
+    psState->iNumEvents    = 0;
+    psState->ullNumDropped = 0;
+    psState->iNextThreadId = 1;
+
+    return (psState);
+}
+
+
+/**
+ * \brief returns the state of the profiler, it is created on first use (thread safe
+ *        initialisation of the static variable, no locking afterwards).
+ */
+static sProfilerState_t& profilerState (void)
+{
+    static sProfilerState_t* psState = createProfilerState ();
+
+    return (*psState);
+}
+
+
+/**
+ * \brief returns the buffer of the calling thread, it is registered on first use.
+ */
+static sThreadBuffer_t* threadBuffer (void)
+{
+    static thread_local std::shared_ptr<sThreadBuffer_t> pclBuffer;
+
+    if (pclBuffer == nullptr)
+    {
+        sProfilerState_t& sState = profilerState ();
+        QMutexLocker      clLocker (&sState.clMutex);
+
+        pclBuffer = std::make_shared<sThreadBuffer_t> ();
+        pclBuffer->iThreadId = sState.iNextThreadId++;
+        pclBuffer->uiCurrent = 0;
+        sState.qvecBuffers.push_back (pclBuffer);
+    }
+
+    return (pclBuffer.get ());
+}
+
+
+void PhaseProfiler::setEnabled (const bool bEnable)
+{
+    // the clock is started, before the first timer reads it
+    profilerState ();
+    bEnabled.store (bEnable, std::memory_order_relaxed);
+}
+
+
+void PhaseProfiler::reset (void)
+{
+    // declaration of variables
+    sProfilerState_t& sState = profilerState ();
+    QMutexLocker      clLocker (&sState.clMutex);
+    QVector<std::shared_ptr<sThreadBuffer_t> > qvecBuffers;
+
+    for (std::shared_ptr<sThreadBuffer_t>& pclBuffer : sState.qvecBuffers)
+    {
+        {
+            QMutexLocker clBufferLocker (&pclBuffer->clMutex);
+            pclBuffer->qvecStats.clear ();
+            pclBuffer->qvecEvents.clear ();
+        }
+
+        // buffers of finished threads are removed
+        if (pclBuffer.use_count () > 1)
+        {
+            qvecBuffers.push_back (pclBuffer);
+        }
+    }
+
+    sState.qvecBuffers   = qvecBuffers;
+    sState.iNumEvents    = 0;
+    sState.ullNumDropped = 0;
+}
+
+
+quint32 PhaseProfiler::enter (const char* pcName, quint32& uiParent, qint64& lliStartNs)
+{
+    // declaration of variables
+    sThreadBuffer_t*           psBuffer = threadBuffer ();
+    QPair<quint32, const char*> qpairKey (psBuffer->uiCurrent, pcName);
+    quint32                     uiPhase  = psBuffer->qhashPhases.value (qpairKey, 0);
+
+    // the phase table is only locked, if the thread enters a phase the first time
+    if (uiPhase == 0)
+    {
+        sProfilerState_t&        sState = profilerState ();
+        QMutexLocker             clLocker (&sState.clMutex);
+        QPair<quint32, QString>  qpairNameKey (qpairKey.first, QString::fromLatin1 (pcName));
+
+        uiPhase = sState.qhashPhases.value (qpairNameKey, 0);
+        if (uiPhase == 0)
+        {
+            const sPhaseNode_t& sParent = sState.qvecPhases [qpairKey.first];
+
+            uiPhase = sState.qvecPhases.size ();
+            sState.qvecPhases.push_back ({qpairKey.first, qpairNameKey.second,
+                                          (sParent.iDepth < 0) ? qpairNameKey.second : sParent.qstrPath + QLatin1Char ('/') + qpairNameKey.second,
+                                          sParent.iDepth + 1});
+            sState.qhashPhases.insert (qpairNameKey, uiPhase);
+        }
+
+        psBuffer->qhashPhases.insert (qpairKey, uiPhase);
+    }
+
+    uiParent            = psBuffer->uiCurrent;
+    psBuffer->uiCurrent = uiPhase;
+    lliStartNs          = profilerState ().clClock.nsecsElapsed ();
+
+    return (uiPhase);
+}
+
+
+void PhaseProfiler::leave (const quint32 uiPhase, const quint32 uiParent, const qint64 lliStartNs)
+{
+    // declaration of variables
+    sProfilerState_t& sState        = profilerState ();
+    qint64            lliDurationNs = sState.clClock.nsecsElapsed () - lliStartNs;
+    sThreadBuffer_t*  psBuffer      = threadBuffer ();
+    QMutexLocker      clLocker (&psBuffer->clMutex);
+
+    while (psBuffer->qvecStats.size () <= (int) uiPhase)
+    {
+        psBuffer->qvecStats.push_back ({0, 0, 0, QuantileSketch (C_PHASE_SKETCH_K)});
+    }
+
+    sPhaseAccu_t& sAccu = psBuffer->qvecStats [uiPhase];
+
+    sAccu.ullCount++;
+    sAccu.lliTotalNs += lliDurationNs;
+    sAccu.lliMaxNs    = qMax (sAccu.lliMaxNs, lliDurationNs);
+    sAccu.clSketch.add (lliDurationNs / 1.0e6);
+
+    if (sState.iNumEvents.fetch_add (1, std::memory_order_relaxed) < C_PHASE_MAX_TRACE_EVENTS)
+    {
+        psBuffer->qvecEvents.push_back ({uiPhase, lliStartNs, lliDurationNs});
+    }
+    else
+    {
+        sState.ullNumDropped++;
+    }
+
+    psBuffer->uiCurrent = uiParent;
+}
+
+
+QVector<sPhaseStats_t> PhaseProfiler::statistics (void)
+{
+    // declaration of variables
+    sProfilerState_t&              sState = profilerState ();
+    QMutexLocker                   clLocker (&sState.clMutex);
+    QMap<QString, sPhaseAccu_t>    qmapMerged;
+    QVector<sPhaseStats_t>         qvecStats;
+    sPhaseStats_t                  sStats;
+    int                            iPhase;
+
+    // the same path may have several ids, if the name literals have different addresses
+    for (const std::shared_ptr<sThreadBuffer_t>& pclBuffer : sState.qvecBuffers)
+    {
+        QMutexLocker clBufferLocker (&pclBuffer->clMutex);
+
+        for (iPhase = 0; iPhase < pclBuffer->qvecStats.size (); iPhase++)
+        {
+            const sPhaseAccu_t& sAccu    = pclBuffer->qvecStats [iPhase];
+            const QString&      qstrPath = sState.qvecPhases [iPhase].qstrPath;
+
+            if (sAccu.ullCount == 0)
+            {
+                continue;
+            }
+
+            if (qmapMerged.contains (qstrPath) == false)
+            {
+                qmapMerged.insert (qstrPath, sAccu);
+            }
+            else
+            {
+                sPhaseAccu_t& sMerged = qmapMerged [qstrPath];
+
+                sMerged.ullCount   += sAccu.ullCount;
+                sMerged.lliTotalNs += sAccu.lliTotalNs;
+                sMerged.lliMaxNs    = qMax (sMerged.lliMaxNs, sAccu.lliMaxNs);
+                sMerged.clSketch.merge (sAccu.clSketch);
+            }
+        }
+    }
+
+    for (QMap<QString, sPhaseAccu_t>::const_iterator itMerged = qmapMerged.constBegin (); itMerged != qmapMerged.constEnd (); ++itMerged)
+    {
+        const sPhaseAccu_t& sAccu = itMerged.value ();
+
+        sStats.qstrPath = itMerged.key ();
+        sStats.qstrName = itMerged.key ().section (QLatin1Char ('/'), -1);
+        sStats.iDepth   = itMerged.key ().count (QLatin1Char ('/'));
+        sStats.ullCount = sAccu.ullCount;
+        sStats.dTotalMs = sAccu.lliTotalNs / 1.0e6;
+        sStats.dMeanMs  = sStats.dTotalMs / sAccu.ullCount;
+        sStats.dP50Ms   = sAccu.clSketch.quantile (0.50);
+        sStats.dP90Ms   = sAccu.clSketch.quantile (0.90);
+        sStats.dP99Ms   = sAccu.clSketch.quantile (0.99);
+        sStats.dMaxMs   = sAccu.lliMaxNs / 1.0e6;
+        qvecStats.push_back (sStats);
+    }
+
+    // the enclosing phases come first
+    std::stable_sort (qvecStats.begin (), qvecStats.end (), [] (const sPhaseStats_t& sA, const sPhaseStats_t& sB)
+    {
+        return (sA.iDepth < sB.iDepth);
+    });
+
+    return (qvecStats);
+}
+
+
+quint64 PhaseProfiler::numDroppedEvents (void)
+{
+    return (profilerState ().ullNumDropped.load ());
+}
+
+
+/**
+ * \brief appends a string as JSON string to a buffer.
+ */
+static void appendJsonString (QByteArray& qbaJson, const QString& qstrValue)
+{
+    // declaration of variables
+    const QByteArray qbaValue = qstrValue.toUtf8 ();
+
+    qbaJson.append ('"');
+    for (const char cValue : qbaValue)
+    {
+        if ((cValue == '"') || (cValue == '\\'))
+        {
+            qbaJson.append ('\\');
+            qbaJson.append (cValue);
+        }
+        else if ((unsigned char) cValue < 0x20)
+        {
+            qbaJson.append (QByteArray ("\\u00") + QByteArray::number ((unsigned char) cValue, 16).rightJustified (2, '0'));
+        }
+        else
+        {
+            qbaJson.append (cValue);
+        }
+    }
+    qbaJson.append ('"');
+}
+
+
+bool PhaseProfiler::writeChromeTrace (const QString& qstrFileName, QString& qstrError)
+{
+    // declaration of variables
+    sProfilerState_t& sState = profilerState ();
+    QMutexLocker      clLocker (&sState.clMutex);
+    QFile             clFile (qstrFileName);
+    QByteArray        qbaJson;
+    bool              bFirst = true;
+
+    if (clFile.open (QIODevice::WriteOnly | QIODevice::Truncate) == false)
+    {
+        qstrError = clFile.errorString ();
+        return (false);
+    }
+
+    // complete events ("X") with microsecond timestamps, one track per thread
+    qbaJson.append ("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    for (const std::shared_ptr<sThreadBuffer_t>& pclBuffer : sState.qvecBuffers)
+    {
+        QMutexLocker clBufferLocker (&pclBuffer->clMutex);
+
+        if (bFirst == false)
+        {
+            qbaJson.append (",\n");
+        }
+        bFirst = false;
+
+        qbaJson.append ("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+        qbaJson.append (QByteArray::number (pclBuffer->iThreadId));
+        qbaJson.append (",\"args\":{\"name\":\"thread ");
+        qbaJson.append (QByteArray::number (pclBuffer->iThreadId));
+        qbaJson.append ("\"}}");
+
+        for (const sPhaseEvent_t& sEvent : pclBuffer->qvecEvents)
+        {
+            const sPhaseNode_t& sNode = sState.qvecPhases [sEvent.uiPhase];
+
+            qbaJson.append (",\n{\"name\":");
+            appendJsonString (qbaJson, sNode.qstrName);
+            qbaJson.append (",\"cat\":");
+            appendJsonString (qbaJson, sState.qvecPhases [sNode.uiParent].qstrPath);
+            qbaJson.append (",\"ph\":\"X\",\"pid\":1,\"tid\":");
+            qbaJson.append (QByteArray::number (pclBuffer->iThreadId));
+            qbaJson.append (",\"ts\":");
+            qbaJson.append (QByteArray::number (sEvent.lliStartNs / 1000.0, 'f', 3));
+            qbaJson.append (",\"dur\":");
+            qbaJson.append (QByteArray::number (sEvent.lliDurationNs / 1000.0, 'f', 3));
+            qbaJson.append ('}');
+
+            // the file is written in blocks
+            if (qbaJson.size () >= (1 << 20))
+            {
+                if (clFile.write (qbaJson) != qbaJson.size ())
+                {
+                    qstrError = clFile.errorString ();
+                    return (false);
+                }
+                qbaJson.clear ();
+            }
+        }
+    }
+
+    qbaJson.append ("\n]}\n");
+    if (clFile.write (qbaJson) != qbaJson.size ())
+    {
+        qstrError = clFile.errorString ();
+        return (false);
+    }
+
+    clFile.close ();
+
+    return (true);
+}
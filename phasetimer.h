@@ -0,0 +1,250 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file phasetimer.h
+ *
+ * \brief contains the defintion of the PhaseTimer and PhaseProfiler classes.
+ *
+ * ---
+ */
+
+
+#ifndef PHASETIMER_H
+#define PHASETIMER_H
+
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+
+
+/**
+ * max. number of recorded events for the trace export, all threads together. The
+ * statistics of the phases still count all events, if the limit has been reached.
+ */
+#define C_PHASE_MAX_TRACE_EVENTS 2000000
+
+
+/**
+ * statistics of a phase. The path contains the names of all enclosing phases,
+ * separated by "/", e.g. "ingest_decode/log_decode/timestamp".
+ */
+typedef struct
+{
+    QString qstrPath;       ///< path of the phase
+    QString qstrName;       ///< name of the phase
+    int     iDepth;         ///< number of enclosing phases
+    quint64 ullCount;       ///< number of calls
+    double  dTotalMs;       ///< total time [ms]
+    double  dMeanMs;        ///< mean time per call [ms]
+    double  dP50Ms;         ///< median [ms]
+    double  dP90Ms;         ///< 90 % percentile [ms]
+    double  dP99Ms;         ///< 99 % percentile [ms]
+    double  dMaxMs;         ///< max. time [ms]
+} sPhaseStats_t;
+
+
+/**
+ * \class PhaseProfiler
+ *
+ * \brief Collects the timings of the PhaseTimer scopes of all threads.
+ *
+ * Each thread writes into its own buffer, that is only locked by the thread itself
+ * and by the functions, that read or reset the timings. The phases are identified by
+ * their path, hence the same phase name below different callers is counted separately.
+ * The percentiles are computed with a QuantileSketch per phase and thread, the sketches
+ * of all threads are merged for the statistics.
+ * If the profiler is disabled, a PhaseTimer only reads an atomic flag.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class PhaseProfiler
+{
+    private:
+        /**
+         * true: the timers record their phases.
+         */
+        static std::atomic<bool> bEnabled;
+
+    public:
+        /**
+         * \brief Returns, if the timers record their phases.
+         *
+         * \return bool = true: enabled / false: disabled
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static inline bool isEnabled (void)
+        {
+            return (bEnabled.load (std::memory_order_relaxed));
+        }
+
+        /**
+         * \brief Enables or disables the recording, the recorded timings are kept.
+         *
+         * @param[in] const bool bEnable = true: enable / false: disable
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static void setEnabled (const bool bEnable);
+
+        /**
+         * \brief Removes all recorded timings.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static void reset (void);
+
+        /**
+         * \brief Returns the statistics of all recorded phases.
+         *
+         * \return QVector<sPhaseStats_t> = statistics, sorted by depth and path
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static QVector<sPhaseStats_t> statistics (void);
+
+        /**
+         * \brief Returns the number of events, that did not fit into the trace.
+         *
+         * \return quint64 = number of dropped trace events
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static quint64 numDroppedEvents (void);
+
+        /**
+         * \brief Writes the recorded events as Chrome trace (JSON), that can be opened
+         *        with chrome://tracing or Perfetto.
+         *
+         * @param[in] const QString& qstrFileName = name of the JSON file
+         * @param[out] QString& qstrError = error message
+         * \return bool = true: OK / false: unable to write the file
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool writeChromeTrace (const QString& qstrFileName, QString& qstrError);
+
+        /**
+         * \brief Enters a phase of the calling thread, only used by PhaseTimer.
+         *
+         * @param[in] const char* pcName = name of the phase (string literal)
+         * @param[out] quint32& uiParent = enclosing phase
+         * @param[out] qint64& lliStartNs = start time [ns]
+         * \return quint32 = id of the phase
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static quint32 enter (const char* pcName, quint32& uiParent, qint64& lliStartNs);
+
+        /**
+         * \brief Leaves a phase of the calling thread, only used by PhaseTimer.
+         *
+         * @param[in] const quint32 uiPhase = id of the phase
+         * @param[in] const quint32 uiParent = enclosing phase
+         * @param[in] const qint64 lliStartNs = start time [ns]
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static void leave (const quint32 uiPhase, const quint32 uiParent, const qint64 lliStartNs);
+};
+
+
+/**
+ * \class PhaseTimer
+ *
+ * \brief Scoped timer, that records the time from its construction to its destruction.
+ *
+ * Timers of one thread are nested, the phase of a timer is the child of the phase
+ * of the enclosing timer:
+ *
+ *     PhaseTimer clTimer ("xml_parse");
+ *
+ * The name has to be a string literal (or any other string, that lives as long as
+ * the program).
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class PhaseTimer
+{
+    private:
+        quint32 uiPhase;
+        quint32 uiParent;
+        qint64  lliStartNs;
+        bool    bActive;
+
+    public:
+        /**
+         * \brief This is the class constructor, it enters the phase.
+         *
+         * ---
+         *
+         * @param[in] const char* pcName = name of the phase
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        explicit inline PhaseTimer (const char* pcName)
+        {
+            this->bActive = PhaseProfiler::isEnabled ();
+            if (this->bActive == true)
+            {
+                this->uiPhase = PhaseProfiler::enter (pcName, this->uiParent, this->lliStartNs);
+            }
+        }
+
+        /**
+         * \brief This is the class destructor, it leaves the phase.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        inline ~PhaseTimer (void)
+        {
+            if (this->bActive == true)
+            {
+                PhaseProfiler::leave (this->uiPhase, this->uiParent, this->lliStartNs);
+            }
+        }
+
+        Q_DISABLE_COPY (PhaseTimer)
+};
+
+#endif // PHASETIMER_H
@@ -0,0 +1,233 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file phaseview.cpp
+ *
+ * \brief contains the implementation of the PhaseView class.
+ *
+ * ---
+ */
+
+
+#include "phaseview.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QPushButton>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QHash>
+
+#include <cmath>
+
+
+/**
+ * columns of the phase tree.
+ */
+enum
+{
+    C_PHASE_COL_NAME = 0,
+    C_PHASE_COL_COUNT,
+    C_PHASE_COL_TOTAL,
+    C_PHASE_COL_MEAN,
+    C_PHASE_COL_P50,
+    C_PHASE_COL_P90,
+    C_PHASE_COL_P99,
+    C_PHASE_COL_MAX,
+    C_PHASE_NUM_COLUMNS
+};
+
+
+/**
+ * \brief tree item, that sorts the numeric columns by value.
+ */
+class PhaseItem : public QTreeWidgetItem
+{
+    public:
+        bool operator< (const QTreeWidgetItem& clOther) const
+        {
+            // declaration of variables
+            int iColumn = this->treeWidget ()->sortColumn ();
+
+            if (iColumn == C_PHASE_COL_NAME)
+            {
+                return (QTreeWidgetItem::operator< (clOther));
+            }
+
+            return (this->data (iColumn, Qt::UserRole).toDouble () < clOther.data (iColumn, Qt::UserRole).toDouble ());
+        }
+};
+
+
+/**
+ * \brief sets the text and the sort value of a time column [ms].
+ */
+static void setTime (QTreeWidgetItem* pclItem, const int iColumn, const double dValueMs)
+{
+    pclItem->setText          (iColumn, (std::isnan (dValueMs) == true) ? QStringLiteral ("-") : QString::number (dValueMs, 'f', 3));
+    pclItem->setData          (iColumn, Qt::UserRole, dValueMs);
+    pclItem->setTextAlignment (iColumn, Qt::AlignRight | Qt::AlignVCenter);
+}
+
+
+PhaseView::PhaseView (QWidget* pclParent) :
+    QDialog (pclParent)
+{
+    // declaration of variables
+    QVBoxLayout* pclLayout  = new QVBoxLayout (this);
+    QHBoxLayout* pclButtons = new QHBoxLayout ();
+    QPushButton* pclRefresh = new QPushButton ("Refresh",              this);
+    QPushButton* pclReset   = new QPushButton ("Reset",                this);
+    QPushButton* pclExport  = new QPushButton ("Export Chrome Trace...", this);
+
+    this->setWindowTitle ("Diagnostics");
+    this->resize (900, 500);
+
+    this->pclEnabled = new QCheckBox ("Record phase timings", this);
+    this->pclEnabled->setChecked (PhaseProfiler::isEnabled ());
+    this->pclDropped = new QLabel (this);
+
+    this->pclTree = new QTreeWidget (this);
+    this->pclTree->setColumnCount  (C_PHASE_NUM_COLUMNS);
+    this->pclTree->setHeaderLabels (QStringList () << "Phase"
+                                                   << "Count"
+                                                   << "Total [ms]"
+                                                   << "Mean [ms]"
+                                                   << "P50 [ms]"
+                                                   << "P90 [ms]"
+                                                   << "P99 [ms]"
+                                                   << "Max. [ms]");
+    this->pclTree->header ()->setSectionResizeMode (QHeaderView::ResizeToContents);
+    this->pclTree->setSortingEnabled (true);
+    this->pclTree->sortByColumn (C_PHASE_COL_TOTAL, Qt::DescendingOrder);
+
+    pclButtons->addWidget  (this->pclEnabled);
+    pclButtons->addWidget  (this->pclDropped);
+    pclButtons->addStretch ();
+    pclButtons->addWidget  (pclRefresh);
+    pclButtons->addWidget  (pclReset);
+    pclButtons->addWidget  (pclExport);
+
+    pclLayout->addLayout (pclButtons);
+    pclLayout->addWidget (this->pclTree);
+
+    connect (this->pclEnabled, SIGNAL (toggled (bool)), this, SLOT (enableToggled (bool)));
+    connect (pclRefresh,       SIGNAL (clicked ()),     this, SLOT (showPhases ()));
+    connect (pclReset,         SIGNAL (clicked ()),     this, SLOT (resetClicked ()));
+    connect (pclExport,        SIGNAL (clicked ()),     this, SLOT (exportClicked ()));
+
+    this->showPhases ();
+}
+
+
+void PhaseView::showPhases (void)
+{
+    // declaration of variables
+    QHash<QString, QTreeWidgetItem*> qhashItems;
+    QTreeWidgetItem*                 pclItem;
+    QTreeWidgetItem*                 pclParent;
+    quint64                          ullDropped = PhaseProfiler::numDroppedEvents ();
+
+    this->pclTree->setSortingEnabled (false);
+    this->pclTree->clear ();
+
+    // the statistics are sorted by depth, hence the parents exist before their children
+    for (const sPhaseStats_t& sStats : PhaseProfiler::statistics ())
+    {
+        pclParent = qhashItems.value (sStats.qstrPath.section (QLatin1Char ('/'), 0, -2), NULL);
+        pclItem   = new PhaseItem ();
+
+        pclItem->setText          (C_PHASE_COL_NAME,  sStats.qstrName);
+        pclItem->setToolTip       (C_PHASE_COL_NAME,  sStats.qstrPath);
+        pclItem->setText          (C_PHASE_COL_COUNT, QString::number (sStats.ullCount));
+        pclItem->setData          (C_PHASE_COL_COUNT, Qt::UserRole, (double) sStats.ullCount);
+        pclItem->setTextAlignment (C_PHASE_COL_COUNT, Qt::AlignRight | Qt::AlignVCenter);
+        setTime (pclItem, C_PHASE_COL_TOTAL, sStats.dTotalMs);
+        setTime (pclItem, C_PHASE_COL_MEAN,  sStats.dMeanMs);
+        setTime (pclItem, C_PHASE_COL_P50,   sStats.dP50Ms);
+        setTime (pclItem, C_PHASE_COL_P90,   sStats.dP90Ms);
+        setTime (pclItem, C_PHASE_COL_P99,   sStats.dP99Ms);
+        setTime (pclItem, C_PHASE_COL_MAX,   sStats.dMaxMs);
+
+        if (pclParent != NULL)
+        {
+            pclParent->addChild (pclItem);
+        }
+        else
+        {
+            this->pclTree->addTopLevelItem (pclItem);
+        }
+        qhashItems.insert (sStats.qstrPath, pclItem);
+    }
+
+    this->pclTree->expandAll ();
+    this->pclTree->setSortingEnabled (true);
+
+    if (ullDropped > 0)
+    {
+        this->pclDropped->setText (QString ("%1 events not in the trace").arg (ullDropped));
+    }
+    else
+    {
+        this->pclDropped->clear ();
+    }
+}
+
+
+void PhaseView::enableToggled (bool bEnable)
+{
+    PhaseProfiler::setEnabled (bEnable);
+}
+
+
+void PhaseView::resetClicked (void)
+{
+    PhaseProfiler::reset ();
+    this->showPhases ();
+}
+
+
+void PhaseView::exportClicked (void)
+{
+    // declaration of variables
+    QString qstrError;
+    QString qstrFileName = QFileDialog::getSaveFileName (this, "Export Chrome Trace", "", "Chrome Trace (*.json)");
+
+    if (qstrFileName.isEmpty () == true)
+    {
+        return;
+    }
+
+    if (PhaseProfiler::writeChromeTrace (qstrFileName, qstrError) == false)
+    {
+        QMessageBox::warning (this, "Unable to export Trace", "Unable to write " + qstrFileName + "!\n" + qstrError);
+    }
+}
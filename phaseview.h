@@ -0,0 +1,101 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file phaseview.h
+ *
+ * \brief contains the defintion of the PhaseView class.
+ *
+ * ---
+ */
+
+
+#ifndef PHASEVIEW_H
+#define PHASEVIEW_H
+
+#include <QDialog>
+#include <QTreeWidget>
+#include <QCheckBox>
+#include <QLabel>
+
+#include "phasetimer.h"
+
+
+/**
+ * \class PhaseView
+ *
+ * \brief Diagnostics dialog with the timings of the load and plot phases.
+ *
+ * The phases are shown as tree, the enclosing phases are the parents. The timing
+ * can be switched on and off, reset and exported as Chrome trace.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class PhaseView : public QDialog
+{
+    Q_OBJECT
+
+    private:
+        /**
+         * tree of the phases, switch of the profiler and number of dropped trace events.
+         */
+        QTreeWidget* pclTree;
+        QCheckBox*   pclEnabled;
+        QLabel*      pclDropped;
+
+    private slots:
+        void enableToggled  (bool bEnable);
+        void resetClicked   (void);
+        void exportClicked  (void);
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] QWidget* pclParent = parent widget
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        explicit PhaseView (QWidget* pclParent = 0);
+
+    public slots:
+        /**
+         * \brief Shows the current statistics of all phases.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void showPhases (void);
+};
+
+#endif // PHASEVIEW_H
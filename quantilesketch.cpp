@@ -0,0 +1,270 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file quantilesketch.cpp
+ *
+ * \brief contains the implementation of the QuantileSketch class.
+ *
+ * ---
+ */
+
+
+#include "quantilesketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+
+QuantileSketch::QuantileSketch (const int iKValue)
+{
+    this->iK = qMax (iKValue, 8);
+    this->clear ();
+}
+
+
+void QuantileSketch::clear (void)
+{
+    this->ullCount = 0;
+    this->dMin     = std::numeric_limits<double>::quiet_NaN ();
+    this->dMax     = std::numeric_limits<double>::quiet_NaN ();
+    this->iSize    = 0;
+    this->iMaxSize = 0;
+    this->uiRandom = 0x9E3779B9u;
+    this->qvecLevels.clear ();
+    this->grow ();
+}
+
+
+int QuantileSketch::capacity (const int iLevel) const
+{
+    // the top level has capacity k, every level below 2/3 of the one above
+    const int iDepth = this->qvecLevels.size () - iLevel - 1;
+
+    return (qMax ((int) std::ceil (this->iK * std::pow (2.0 / 3.0, iDepth)), 2));
+}
+
+
+void QuantileSketch::grow (void)
+{
+    // declaration of variables
+    int iLevel;
+
+    this->qvecLevels.push_back (QVector<double> ());
+
+    this->iMaxSize = 0;
+    for (iLevel = 0; iLevel < this->qvecLevels.size (); iLevel++)
+    {
+        this->iMaxSize += this->capacity (iLevel);
+    }
+}
+
+
+void QuantileSketch::compress (void)
+{
+    // declaration of variables
+    int iLevel;
+    int iStart;
+    int iCounter;
+
+    for (iLevel = 0; iLevel < this->qvecLevels.size (); iLevel++)
+    {
+        if (this->qvecLevels [iLevel].size () >= this->capacity (iLevel))
+        {
+            if ((iLevel + 1) >= this->qvecLevels.size ())
+            {
+                this->grow ();
+            }
+
+            QVector<double>& qvecLevel = this->qvecLevels [iLevel];
+            QVector<double>& qvecUpper = this->qvecLevels [iLevel + 1];
+
+            std::sort (qvecLevel.begin (), qvecLevel.end ());
+
+            // with an odd number of values the smallest one stays on this level
+            iStart = qvecLevel.size () % 2;
+
+            this->uiRandom ^= this->uiRandom << 13;
+            this->uiRandom ^= this->uiRandom >> 17;
+            this->uiRandom ^= this->uiRandom << 5;
+
+            for (iCounter = iStart + (int) (this->uiRandom & 1u); iCounter < qvecLevel.size (); iCounter += 2)
+            {
+                qvecUpper.push_back (qvecLevel [iCounter]);
+            }
+            qvecLevel.resize (iStart);
+
+            // one compaction per call is enough to get below the max. size again
+            break;
+        }
+    }
+
+    this->iSize = 0;
+    for (iLevel = 0; iLevel < this->qvecLevels.size (); iLevel++)
+    {
+        this->iSize += this->qvecLevels [iLevel].size ();
+    }
+}
+
+
+void QuantileSketch::add (const double dValue)
+{
+    if (std::isnan (dValue) == true)
+    {
+        return;
+    }
+
+    if (this->ullCount == 0)
+    {
+        this->dMin = dValue;
+        this->dMax = dValue;
+    }
+    else
+    {
+        this->dMin = qMin (this->dMin, dValue);
+        this->dMax = qMax (this->dMax, dValue);
+    }
+    this->ullCount++;
+
+    this->qvecLevels [0].push_back (dValue);
+    this->iSize++;
+    if (this->iSize >= this->iMaxSize)
+    {
+        this->compress ();
+    }
+}
+
+
+void QuantileSketch::merge (const QuantileSketch& clOther)
+{
+    // declaration of variables
+    int iLevel;
+
+    if (clOther.ullCount == 0)
+    {
+        return;
+    }
+
+    if (this->ullCount == 0)
+    {
+        this->dMin = clOther.dMin;
+        this->dMax = clOther.dMax;
+    }
+    else
+    {
+        this->dMin = qMin (this->dMin, clOther.dMin);
+        this->dMax = qMax (this->dMax, clOther.dMax);
+    }
+    this->ullCount += clOther.ullCount;
+
+    while (this->qvecLevels.size () < clOther.qvecLevels.size ())
+    {
+        this->grow ();
+    }
+
+    for (iLevel = 0; iLevel < clOther.qvecLevels.size (); iLevel++)
+    {
+        this->qvecLevels [iLevel] += clOther.qvecLevels [iLevel];
+        this->iSize               += clOther.qvecLevels [iLevel].size ();
+    }
+
+    while (this->iSize >= this->iMaxSize)
+    {
+        this->compress ();
+    }
+}
+
+
+double QuantileSketch::quantile (const double dQuantile) const
+{
+    // declaration of variables
+    std::vector<std::pair<double, quint64> > vecItems;
+    quint64                                 ullTotal  = 0;
+    quint64                                 ullWeight = 0;
+    double                                  dTarget;
+    int                                     iLevel;
+
+    if (this->ullCount == 0)
+    {
+        return (std::numeric_limits<double>::quiet_NaN ());
+    }
+    if (dQuantile <= 0.0)
+    {
+        return (this->dMin);
+    }
+    if (dQuantile >= 1.0)
+    {
+        return (this->dMax);
+    }
+
+    // values of level h have the weight 2^h
+    vecItems.reserve (this->iSize);
+    for (iLevel = 0; iLevel < this->qvecLevels.size (); iLevel++)
+    {
+        for (const double dValue : this->qvecLevels [iLevel])
+        {
+            vecItems.push_back (std::make_pair (dValue, ((quint64) 1) << iLevel));
+            ullTotal += ((quint64) 1) << iLevel;
+        }
+    }
+    std::sort (vecItems.begin (), vecItems.end ());
+
+    dTarget = dQuantile * (double) ullTotal;
+    for (const std::pair<double, quint64>& sItem : vecItems)
+    {
+        ullWeight += sItem.second;
+        if ((double) ullWeight >= dTarget)
+        {
+            return (sItem.first);
+        }
+    }
+
+    return (this->dMax);
+}
+
+
+quint64 QuantileSketch::count (void) const
+{
+    return (this->ullCount);
+}
+
+
+double QuantileSketch::minimum (void) const
+{
+    return (this->dMin);
+}
+
+
+double QuantileSketch::maximum (void) const
+{
+    return (this->dMax);
+}
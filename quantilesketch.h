@@ -0,0 +1,187 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file quantilesketch.h
+ *
+ * \brief contains the defintion of the QuantileSketch class.
+ *
+ * ---
+ */
+
+
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+#include <QVector>
+
+
+/**
+ * \class QuantileSketch
+ *
+ * \brief Mergeable streaming quantile sketch (KLL).
+ *
+ * The sketch keeps a hierarchy of compactors. Level h stores values with the
+ * weight 2^h. If the sketch is full, the lowest full level is sorted and every
+ * second value (random offset) is moved to the next level. The memory is bound
+ * by about 3 * k values, independent of the number of added values. The rank
+ * error is about 1.7 / k, e.g. < 1.5 % for the default k = 128.
+ * Two sketches are merged by concatenating their levels and compacting again,
+ * hence sketches of days or stations can be combined for any range.
+ * Min. and max. are kept exactly.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class QuantileSketch
+{
+    private:
+        /**
+         * accuracy parameter k.
+         */
+        int iK;
+
+        /**
+         * number of added values, exact min. and max.
+         */
+        quint64 ullCount;
+        double  dMin;
+        double  dMax;
+
+        /**
+         * compactor levels, number of stored values and max. number of stored values.
+         */
+        QVector<QVector<double> > qvecLevels;
+        int                       iSize;
+        int                       iMaxSize;
+
+        /**
+         * state of the random generator (xorshift), that selects the compaction offsets.
+         */
+        quint32 uiRandom;
+
+        /**
+         * \brief Returns the capacity of a level.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        int capacity (const int iLevel) const;
+
+        /**
+         * \brief Adds a new level on top.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void grow (void);
+
+        /**
+         * \brief Compacts the lowest full level into the next one.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void compress (void);
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const int iKValue = accuracy parameter k (min. 8)
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QuantileSketch (const int iKValue = 128);
+
+        /**
+         * \brief Adds a value, NaN values are ignored.
+         *
+         * @param[in] const double dValue = value
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void add (const double dValue);
+
+        /**
+         * \brief Merges another sketch into this one.
+         *
+         * @param[in] const QuantileSketch& clOther = sketch to be merged
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void merge (const QuantileSketch& clOther);
+
+        /**
+         * \brief Returns the approximate quantile.
+         *
+         * @param[in] const double dQuantile = quantile (0.0 ... 1.0), e.g. 0.5 for the median
+         * \return double = value / NaN if the sketch is empty
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        double quantile (const double dQuantile) const;
+
+        /**
+         * \brief Returns the number of added values.
+         *
+         * \return quint64 = number of values
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        quint64 count (void) const;
+
+        /**
+         * \brief Returns the exact min. / max. of the added values.
+         *
+         * \return double = min. / max. value, NaN if the sketch is empty
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        double minimum (void) const;
+        double maximum (void) const;
+
+        /**
+         * \brief Removes all values.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void clear (void);
+};
+
+#endif // QUANTILESKETCH_H
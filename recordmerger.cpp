@@ -0,0 +1,335 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file recordmerger.cpp
+ *
+ * \brief contains the implementation of the record sources and the RecordMerger class.
+ *
+ * ---
+ */
+
+
+#include "recordmerger.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+
+RecordSource::~RecordSource (void)
+{
+}
+
+
+MeasDocRecordSource::MeasDocRecordSource (QIODevice* pclDevice, LogDecoderRegistry& clDecodersRef) :
+    clReader   (pclDevice),
+    clDecoders (clDecodersRef)
+{
+    this->iNumFields = 0;
+    this->iDepth     = 0;
+    this->bLeaf      = false;
+}
+
+
+bool MeasDocRecordSource::next (sLogRecord_t& sRecord)
+{
+    // declaration of variables
+    static const char* const apcSerialTags [] = C_MEASDOC_SERIAL_TAGS;
+    QString                  qstrComponent;
+    int                      iCounter;
+
+    while (this->clReader.atEnd () == false)
+    {
+        this->clReader.readNext ();
+
+        if (this->clReader.isStartElement () == true)
+        {
+            if (this->iDepth > 0)
+            {
+                this->iDepth++;
+                this->bLeaf = true;
+                this->qstrText.clear ();
+            }
+            else if (this->clReader.name () == QLatin1String ("message"))
+            {
+                this->iDepth     = 1;
+                this->iNumFields = 0;
+                this->bLeaf      = false;
+            }
+            else if (this->qstrSerial.isEmpty () == true)
+            {
+                for (const char* pcTag : apcSerialTags)
+                {
+                    if (this->clReader.name () == QLatin1String (pcTag))
+                    {
+                        this->qstrSerial = this->clReader.readElementText (QXmlStreamReader::IncludeChildElements).trimmed ();
+                        break;
+                    }
+                }
+            }
+        }
+        else if ((this->clReader.isCharacters () == true) && (this->bLeaf == true))
+        {
+            this->qstrText += this->clReader.text ();
+        }
+        else if ((this->clReader.isEndElement () == true) && (this->iDepth > 1))
+        {
+            // leaf node: element with text, but without child elements
+            if ((this->bLeaf == true) && (this->qstrText.trimmed ().isEmpty () == false))
+            {
+                if (this->iNumFields >= this->qvecFields.size ())
+                {
+                    this->qvecFields.resize (this->iNumFields + 1);
+                }
+                this->qvecFields [this->iNumFields].qstrTag   = this->clReader.name ().toString ();
+                this->qvecFields [this->iNumFields].qstrValue = this->qstrText;
+                this->iNumFields++;
+            }
+
+            this->bLeaf = false;
+            this->iDepth--;
+        }
+        else if ((this->clReader.isEndElement () == true) && (this->iDepth == 1))
+        {
+            this->iDepth = 0;
+
+            qstrComponent.clear ();
+            for (iCounter = 0; iCounter < this->iNumFields; iCounter++)
+            {
+                if (this->qvecFields [iCounter].qstrTag == QLatin1String ("component"))
+                {
+                    qstrComponent = this->qvecFields [iCounter].qstrValue.trimmed ();
+                    break;
+                }
+            }
+
+            if ((qstrComponent.isEmpty () == false) &&
+                (this->clDecoders.decodeFields (qstrComponent, this->qvecFields.constData (), this->iNumFields, sRecord) == true))
+            {
+                return (true);
+            }
+        }
+    }
+
+    return (false);
+}
+
+
+bool MeasDocRecordSource::serialNumber (QString& qstrSerialNumber) const
+{
+    qstrSerialNumber = this->qstrSerial;
+
+    return (this->qstrSerial.isEmpty () == false);
+}
+
+
+QString MeasDocRecordSource::errorString (void) const
+{
+    if (this->clReader.hasError () == true)
+    {
+        return (this->clReader.errorString ());
+    }
+
+    return (QString ());
+}
+
+
+RecordVectorSource::RecordVectorSource (const QVector<sLogRecord_t>& qvecRecordsRef)
+{
+    this->qvecRecords = qvecRecordsRef;
+    this->iIndex      = 0;
+}
+
+
+bool RecordVectorSource::next (sLogRecord_t& sRecord)
+{
+    if (this->iIndex >= this->qvecRecords.size ())
+    {
+        return (false);
+    }
+
+    sRecord = this->qvecRecords [this->iIndex++];
+
+    return (true);
+}
+
+
+StoreRecordSource::StoreRecordSource (const TelemetryStore& clStore, const bool bSortRows)
+{
+    // declaration of variables
+    int iCounter;
+
+    for (const QString& qstrComponent : clStore.components ())
+    {
+        const TelemetrySeries*  pclSeries      = &clStore.series (qstrComponent);
+        const QVector<qint64>&  qvecTimeStamps = pclSeries->timeStamps ();
+
+        this->qvecSeries.push_back (pclSeries);
+        this->qvecRows.push_back (0);
+
+        if (bSortRows == true)
+        {
+            QVector<int> qvecRowOrder (qvecTimeStamps.size ());
+            for (iCounter = 0; iCounter < qvecRowOrder.size (); iCounter++)
+            {
+                qvecRowOrder [iCounter] = iCounter;
+            }
+
+            std::stable_sort (qvecRowOrder.begin (), qvecRowOrder.end (), [&qvecTimeStamps] (const int iA, const int iB)
+            {
+                return (qvecTimeStamps [iA] < qvecTimeStamps [iB]);
+            });
+
+            this->qvecOrder.push_back (qvecRowOrder);
+        }
+    }
+}
+
+
+int StoreRecordSource::row (const int iSeries, const int iIndex) const
+{
+    if (this->qvecOrder.isEmpty () == true)
+    {
+        return (iIndex);
+    }
+
+    return (this->qvecOrder [iSeries][iIndex]);
+}
+
+
+bool StoreRecordSource::next (sLogRecord_t& sRecord)
+{
+    // declaration of variables
+    int iCounter;
+    int iNext = -1;
+    int iRow;
+
+    // the number of components is small, a linear search for the oldest row is enough
+    for (iCounter = 0; iCounter < this->qvecSeries.size (); iCounter++)
+    {
+        if ((this->qvecRows [iCounter] < this->qvecSeries [iCounter]->size ()) &&
+            ((iNext < 0) ||
+             (this->qvecSeries [iCounter]->timeStamps () [this->row (iCounter, this->qvecRows [iCounter])] <
+              this->qvecSeries [iNext]->timeStamps () [this->row (iNext, this->qvecRows [iNext])])))
+        {
+            iNext = iCounter;
+        }
+    }
+
+    if (iNext < 0)
+    {
+        return (false);
+    }
+
+    const TelemetrySeries& clSeries = *this->qvecSeries [iNext];
+    iRow = this->row (iNext, this->qvecRows [iNext]++);
+
+    sRecord.qstrComponent = clSeries.component ();
+    sRecord.tTimeStamp    = clSeries.timeStamps () [iRow];
+    sRecord.qvecChannels  = clSeries.channelNames ();
+    sRecord.qvecValues.resize (sRecord.qvecChannels.size ());
+    for (iCounter = 0; iCounter < sRecord.qvecChannels.size (); iCounter++)
+    {
+        sRecord.qvecValues [iCounter] = clSeries.column (sRecord.qvecChannels [iCounter]) [iRow];
+    }
+
+    return (true);
+}
+
+
+bool RecordMerger::merge (const QVector<RecordSource*>& qvecSources, TelemetryStore& clStore, sMergeStats_t* psStats)
+{
+    // declaration of variables
+    typedef std::pair<qint64, int> tPending_t;
+    std::priority_queue<tPending_t, std::vector<tPending_t>, std::greater<tPending_t> > clHeap;
+    QVector<sLogRecord_t> qvecPending (qvecSources.size ());
+    QSet<QString>         qsetComponents;
+    sMergeStats_t         sStats = {0, 0, 0};
+    qint64                tCurrent = 0;
+    bool                  bRetValue = false;
+    int                   iSource;
+
+    // one pending record per source, the heap is ordered by (timestamp, source index)
+    for (iSource = 0; iSource < qvecSources.size (); iSource++)
+    {
+        if ((qvecSources [iSource] != NULL) && (qvecSources [iSource]->next (qvecPending [iSource]) == true))
+        {
+            clHeap.push (tPending_t (qvecPending [iSource].tTimeStamp, iSource));
+            sStats.iNumRecords++;
+        }
+    }
+
+    while (clHeap.empty () == false)
+    {
+        iSource = clHeap.top ().second;
+        clHeap.pop ();
+
+        const sLogRecord_t& sRecord = qvecPending [iSource];
+
+        // components, that have been merged with the current timestamp
+        if ((bRetValue == false) || (sRecord.tTimeStamp != tCurrent))
+        {
+            if ((bRetValue == true) && (sRecord.tTimeStamp < tCurrent))
+            {
+                sStats.iNumOutOfOrder++;
+            }
+            qsetComponents.clear ();
+            tCurrent = sRecord.tTimeStamp;
+        }
+
+        if (qsetComponents.contains (sRecord.qstrComponent) == true)
+        {
+            sStats.iNumDuplicates++;
+        }
+        else
+        {
+            qsetComponents.insert (sRecord.qstrComponent);
+            clStore.appendRecord (sRecord);
+            bRetValue = true;
+        }
+
+        if (qvecSources [iSource]->next (qvecPending [iSource]) == true)
+        {
+            clHeap.push (tPending_t (qvecPending [iSource].tTimeStamp, iSource));
+            sStats.iNumRecords++;
+        }
+    }
+
+    if (psStats != NULL)
+    {
+        *psStats = sStats;
+    }
+
+    return (bRetValue);
+}
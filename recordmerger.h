@@ -0,0 +1,285 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file recordmerger.h
+ *
+ * \brief contains the defintion of the record sources and the RecordMerger class.
+ *
+ * ---
+ */
+
+
+#ifndef RECORDMERGER_H
+#define RECORDMERGER_H
+
+#include <QString>
+#include <QVector>
+#include <QIODevice>
+#include <QXmlStreamReader>
+
+#include "telemetrystore.h"
+#include "logdecoder.h"
+#include "xmlparses.h"
+
+
+/**
+ * names of the nodes, that may contain the serial number of the station inside a
+ * MeasDoc.
+ */
+#define C_MEASDOC_SERIAL_TAGS {"serial", "serial_number", "SerialNumber", "ADUSerial"}
+
+
+/**
+ * \class RecordSource
+ *
+ * \brief This is the base class of all sources of decoded log messages.
+ *
+ * A source delivers its records one by one in time order, hence several sources
+ * can be merged in a single pass.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class RecordSource
+{
+    public:
+        virtual ~RecordSource (void);
+
+        /**
+         * \brief Returns the next record.
+         *
+         * @param[out] sLogRecord_t& sRecord = next record
+         * \return bool = true: OK / false: no more records
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        virtual bool next (sLogRecord_t& sRecord) = 0;
+};
+
+
+/**
+ * \class MeasDocRecordSource
+ *
+ * \brief Decodes the "message" nodes of a MeasDoc XML file while it is read.
+ *
+ * The file is read with a streaming XML reader, hence no DOM tree is built. The
+ * leaf nodes of each message are collected and handed to the decoder of its
+ * component. The device can deliver the file as it is read or decompressed (see
+ * DecompressingDevice).
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class MeasDocRecordSource : public RecordSource
+{
+    private:
+        QXmlStreamReader     clReader;
+        LogDecoderRegistry&  clDecoders;
+
+        /**
+         * leaf nodes of the current message, the vector is reused for all messages.
+         */
+        QVector<sLogField_t> qvecFields;
+        int                  iNumFields;
+
+        /**
+         * depth below the current message node (0 = outside of a message), text of the
+         * current node and true, as long as the current node has no child elements.
+         */
+        int                  iDepth;
+        QString              qstrText;
+        bool                 bLeaf;
+
+        /**
+         * serial number of the station, empty until a serial number node has been read.
+         */
+        QString              qstrSerial;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] QIODevice* pclDevice = opened device, needs to stay valid while reading
+         * @param[in] LogDecoderRegistry& clDecodersRef = decoders
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        MeasDocRecordSource (QIODevice* pclDevice, LogDecoderRegistry& clDecodersRef);
+
+        /**
+         * \brief Returns the serial number of the station, that has written the MeasDoc.
+         *
+         * The value of the first serial number node outside of the messages (see
+         * C_MEASDOC_SERIAL_TAGS), that has been read so far, is returned.
+         *
+         * @param[out] QString& qstrSerialNumber = serial number
+         * \return bool = true: OK / false: no serial number found (yet)
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool serialNumber (QString& qstrSerialNumber) const;
+
+        /**
+         * \brief Returns the XML or read error, that has stopped reading.
+         *
+         * \return QString = error text / empty string: no error
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QString errorString (void) const;
+
+        bool next (sLogRecord_t& sRecord) override;
+};
+
+
+/**
+ * \class RecordVectorSource
+ *
+ * \brief Delivers records, that have been decoded before (e.g. by a worker thread).
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class RecordVectorSource : public RecordSource
+{
+    private:
+        QVector<sLogRecord_t> qvecRecords;
+        int                   iIndex;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const QVector<sLogRecord_t>& qvecRecordsRef = records in time order
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        RecordVectorSource (const QVector<sLogRecord_t>& qvecRecordsRef);
+
+        bool next (sLogRecord_t& sRecord) override;
+};
+
+
+/**
+ * \class StoreRecordSource
+ *
+ * \brief Replays the contents of a TelemetryStore as records in time order.
+ *
+ * Used to merge new sources into the telemetry, that is already loaded. The series
+ * are merged by their timestamps, the rows of each series are replayed in their
+ * stored order or sorted by their timestamps (stores, that have been appended out
+ * of time order).
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class StoreRecordSource : public RecordSource
+{
+    private:
+        QVector<const TelemetrySeries*> qvecSeries;
+        QVector<int>                    qvecRows;
+
+        /**
+         * rows of each series in time order, empty: stored order.
+         */
+        QVector<QVector<int> >          qvecOrder;
+
+        int row (const int iSeries, const int iIndex) const;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const TelemetryStore& clStore = store, needs to stay valid while replaying
+         * @param[in] const bool bSortRows = true: the rows of each series are replayed in time order
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        StoreRecordSource (const TelemetryStore& clStore, const bool bSortRows = false);
+
+        bool next (sLogRecord_t& sRecord) override;
+};
+
+
+/**
+ * statistics of a merge.
+ */
+typedef struct
+{
+    int iNumRecords;        ///< number of records read from all sources
+    int iNumDuplicates;     ///< number of records removed as duplicates (same timestamp and component)
+    int iNumOutOfOrder;     ///< number of records older than the previous merged record
+} sMergeStats_t;
+
+
+/**
+ * \class RecordMerger
+ *
+ * \brief Merges several record sources into one store.
+ *
+ * The sources are combined with a k-way merge on the timestamp (binary heap with
+ * one pending record per source), hence the merged records are appended in time
+ * order without sorting. Records with the same timestamp and component are
+ * duplicates, only the first one is kept. On equal timestamps the source with the
+ * lower index is preferred.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class RecordMerger
+{
+    public:
+        /**
+         * \brief Merges the sources and appends the records to a store.
+         *
+         * @param[in] const QVector<RecordSource*>& qvecSources = sources, each one in time order
+         * @param[in,out] TelemetryStore& clStore = store, the records are appended to
+         * @param[out] sMergeStats_t* psStats = statistics, may be NULL
+         * \return bool = true: at least one record has been appended / false: all sources are empty
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool merge (const QVector<RecordSource*>& qvecSources, TelemetryStore& clStore, sMergeStats_t* psStats = NULL);
+};
+
+#endif // RECORDMERGER_H
@@ -0,0 +1,742 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file sqldumpreader.cpp
+ *
+ * \brief contains the implementation of the SqlDumpReader class.
+ *
+ * ---
+ */
+
+
+#include "sqldumpreader.h"
+
+#include <cctype>
+#include <cstring>
+
+
+/**
+ * size of the blocks, that are read from the device, and max. size of a statement
+ * head, that is kept (CREATE TABLE statements, column lists).
+ */
+#define C_SQL_DUMP_BLOCK_SIZE (1024 * 1024)
+#define C_SQL_DUMP_MAX_HEAD   (64 * 1024)
+
+
+/**
+ * \brief reads a (qualified) identifier, plain or in backquotes.
+ *
+ * @param[in] const QByteArray& qbaText = text
+ * @param[in] int iPos = start position, leading white spaces are skipped
+ * @param[out] QByteArray& qbaIdentifier = identifier, last part of a qualified name
+ * @param[out] bool* pbQuoted = true, if the identifier has been quoted (optional)
+ * \return int = position after the identifier / -1: no identifier
+ */
+static int readIdentifier (const QByteArray& qbaText, int iPos, QByteArray& qbaIdentifier, bool* pbQuoted = NULL)
+{
+    // declaration of variables
+    bool bQuoted = false;
+
+    while ((iPos < qbaText.size ()) && (isspace ((unsigned char) qbaText [iPos]) != 0))
+    {
+        iPos++;
+    }
+
+    qbaIdentifier.clear ();
+
+    if ((iPos < qbaText.size ()) && (qbaText [iPos] == '`'))
+    {
+        bQuoted = true;
+        iPos++;
+        while (iPos < qbaText.size ())
+        {
+            if (qbaText [iPos] == '`')
+            {
+                // doubled backquote inside the identifier
+                if ((iPos + 1 < qbaText.size ()) && (qbaText [iPos + 1] == '`'))
+                {
+                    qbaIdentifier.append ('`');
+                    iPos += 2;
+                    continue;
+                }
+                break;
+            }
+            qbaIdentifier.append (qbaText [iPos]);
+            iPos++;
+        }
+
+        if (iPos >= qbaText.size ())
+        {
+            return (-1);
+        }
+        iPos++;
+    }
+    else
+    {
+        while ((iPos < qbaText.size ()) && ((isalnum ((unsigned char) qbaText [iPos]) != 0) ||
+                                            (qbaText [iPos] == '_') || (qbaText [iPos] == '$')))
+        {
+            qbaIdentifier.append (qbaText [iPos]);
+            iPos++;
+        }
+
+        if (qbaIdentifier.isEmpty () == true)
+        {
+            return (-1);
+        }
+    }
+
+    // database.table
+    if ((iPos < qbaText.size ()) && (qbaText [iPos] == '.'))
+    {
+        return (readIdentifier (qbaText, iPos + 1, qbaIdentifier, pbQuoted));
+    }
+
+    if (pbQuoted != NULL)
+    {
+        *pbQuoted = bQuoted;
+    }
+
+    return (iPos);
+}
+
+
+SqlDumpReader::SqlDumpReader (QIODevice* pclDeviceRef, const QByteArray& qbaTableName)
+{
+    this->pclDevice     = pclDeviceRef;
+    this->qbaTable      = qbaTableName.toLower ();
+    this->iBlockSize    = 0;
+    this->iPos          = 0;
+    this->bEndOfFile    = false;
+    this->eState        = STATE_STATEMENT;
+    this->cQuote        = '\'';
+    this->bHeadOverflow = false;
+    this->aiColumns [0] = -1;
+    this->aiColumns [1] = -1;
+    this->aiColumns [2] = -1;
+    this->bCapture      = false;
+    this->iField        = 0;
+    this->pqbaField     = NULL;
+    this->bToken        = false;
+    this->lliNumRows    = 0;
+}
+
+
+bool SqlDumpReader::readBlock (void)
+{
+    // declaration of variables
+    qint64 lliRead;
+
+    this->iPos       = 0;
+    this->iBlockSize = 0;
+
+    if ((this->bEndOfFile == true) || (this->pclDevice == NULL))
+    {
+        return (false);
+    }
+
+    this->qbaBlock.resize (C_SQL_DUMP_BLOCK_SIZE);
+    lliRead = this->pclDevice->read (this->qbaBlock.data (), this->qbaBlock.size ());
+    if (lliRead <= 0)
+    {
+        if ((lliRead < 0) && (this->qstrError.isEmpty () == true))
+        {
+            this->qstrError = this->pclDevice->errorString ();
+        }
+        this->bEndOfFile = true;
+        return (false);
+    }
+
+    this->iBlockSize = (int) lliRead;
+
+    return (true);
+}
+
+
+void SqlDumpReader::parseStatement (void)
+{
+    // declaration of variables
+    QByteArray          qbaWord;
+    QVector<QByteArray> qvecColumns;
+    int                 iNext;
+    int                 iDepth;
+    bool                bItemStart;
+    bool                bQuoted;
+    char                cChar;
+
+    if (this->bHeadOverflow == true)
+    {
+        return;
+    }
+
+    // CREATE [TEMPORARY] TABLE [IF NOT EXISTS] name (definitions)
+    iNext = readIdentifier (this->qbaHead, 0, qbaWord);
+    if ((iNext < 0) || (qbaWord.toUpper () != "CREATE"))
+    {
+        return;
+    }
+
+    do
+    {
+        iNext = readIdentifier (this->qbaHead, iNext, qbaWord, &bQuoted);
+    }
+    while ((iNext >= 0) && (bQuoted == false) &&
+           ((qbaWord.toUpper () == "TEMPORARY") || (qbaWord.toUpper () == "TABLE") || (qbaWord.toUpper () == "IF") ||
+            (qbaWord.toUpper () == "NOT")       || (qbaWord.toUpper () == "EXISTS")));
+
+    if ((iNext < 0) || (qbaWord.toLower () != this->qbaTable))
+    {
+        return;
+    }
+
+    iNext = this->qbaHead.indexOf ('(', iNext);
+    if (iNext < 0)
+    {
+        return;
+    }
+
+    // the first word of each definition is a column name, if it is not a key or constraint
+    iNext++;
+    iDepth     = 1;
+    bItemStart = true;
+    while ((iNext < this->qbaHead.size ()) && (iDepth > 0))
+    {
+        if (bItemStart == true)
+        {
+            bItemStart = false;
+            iNext      = readIdentifier (this->qbaHead, iNext, qbaWord, &bQuoted);
+            if (iNext < 0)
+            {
+                return;
+            }
+
+            if ((bQuoted == true) ||
+                ((qbaWord.toUpper () != "PRIMARY")  && (qbaWord.toUpper () != "KEY")     && (qbaWord.toUpper () != "UNIQUE")     &&
+                 (qbaWord.toUpper () != "INDEX")    && (qbaWord.toUpper () != "FULLTEXT") && (qbaWord.toUpper () != "SPATIAL")   &&
+                 (qbaWord.toUpper () != "FOREIGN")  && (qbaWord.toUpper () != "CONSTRAINT") && (qbaWord.toUpper () != "CHECK")))
+            {
+                qvecColumns.push_back (qbaWord.toLower ());
+            }
+            continue;
+        }
+
+        cChar = this->qbaHead [iNext];
+        iNext++;
+
+        if ((cChar == '\'') || (cChar == '"') || (cChar == '`'))
+        {
+            // skip default values and comments
+            while ((iNext < this->qbaHead.size ()) && (this->qbaHead [iNext] != cChar))
+            {
+                if ((this->qbaHead [iNext] == '\\') && (cChar != '`'))
+                {
+                    iNext++;
+                }
+                iNext++;
+            }
+            iNext++;
+        }
+        else if (cChar == '(')
+        {
+            iDepth++;
+        }
+        else if (cChar == ')')
+        {
+            iDepth--;
+        }
+        else if ((cChar == ',') && (iDepth == 1))
+        {
+            bItemStart = true;
+        }
+    }
+
+    this->qvecTableColumns = qvecColumns;
+}
+
+
+void SqlDumpReader::parseInsert (void)
+{
+    // declaration of variables
+    static const char* const apcColumns [] = {C_SQL_DUMP_COLUMN_COMPONENT, C_SQL_DUMP_COLUMN_TIMESTAMP, C_SQL_DUMP_COLUMN_MESSAGE};
+    QByteArray               qbaWord;
+    QVector<QByteArray>      qvecColumns;
+    int                      iNext;
+    int                      iCounter;
+    bool                     bQuoted;
+
+    this->bCapture      = false;
+    this->aiColumns [0] = -1;
+    this->aiColumns [1] = -1;
+    this->aiColumns [2] = -1;
+
+    if (this->bHeadOverflow == true)
+    {
+        return;
+    }
+
+    // INSERT|REPLACE [LOW_PRIORITY|DELAYED|HIGH_PRIORITY] [IGNORE] [INTO] name [(columns)] VALUES
+    iNext = 0;
+    do
+    {
+        iNext = readIdentifier (this->qbaHead, iNext, qbaWord, &bQuoted);
+    }
+    while ((iNext >= 0) && (bQuoted == false) &&
+           ((qbaWord.toUpper () == "INSERT")  || (qbaWord.toUpper () == "REPLACE")      || (qbaWord.toUpper () == "INTO")    ||
+            (qbaWord.toUpper () == "IGNORE")  || (qbaWord.toUpper () == "LOW_PRIORITY") || (qbaWord.toUpper () == "DELAYED") ||
+            (qbaWord.toUpper () == "HIGH_PRIORITY")));
+
+    if ((iNext < 0) || (qbaWord.toLower () != this->qbaTable))
+    {
+        return;
+    }
+
+    while ((iNext < this->qbaHead.size ()) && (isspace ((unsigned char) this->qbaHead [iNext]) != 0))
+    {
+        iNext++;
+    }
+
+    if ((iNext < this->qbaHead.size ()) && (this->qbaHead [iNext] == '('))
+    {
+        iNext++;
+        while ((iNext = readIdentifier (this->qbaHead, iNext, qbaWord)) >= 0)
+        {
+            qvecColumns.push_back (qbaWord.toLower ());
+
+            while ((iNext < this->qbaHead.size ()) && (isspace ((unsigned char) this->qbaHead [iNext]) != 0))
+            {
+                iNext++;
+            }
+            if ((iNext >= this->qbaHead.size ()) || (this->qbaHead [iNext] != ','))
+            {
+                break;
+            }
+            iNext++;
+        }
+    }
+    else
+    {
+        qvecColumns = this->qvecTableColumns;
+    }
+
+    if (qvecColumns.isEmpty () == true)
+    {
+        this->qstrError = QString ("the column order of table %1 is unknown (no CREATE TABLE statement and no column names)")
+                          .arg (QString::fromUtf8 (this->qbaTable));
+        return;
+    }
+
+    for (iCounter = 0; iCounter < 3; iCounter++)
+    {
+        this->aiColumns [iCounter] = qvecColumns.indexOf (QByteArray (apcColumns [iCounter]));
+    }
+
+    if ((this->aiColumns [0] < 0) || (this->aiColumns [2] < 0))
+    {
+        this->qstrError = QString ("table %1 has no %2 or %3 column")
+                          .arg (QString::fromUtf8 (this->qbaTable))
+                          .arg (C_SQL_DUMP_COLUMN_COMPONENT)
+                          .arg (C_SQL_DUMP_COLUMN_MESSAGE);
+        return;
+    }
+
+    this->bCapture = true;
+}
+
+
+void SqlDumpReader::parseComment (void)
+{
+    // declaration of variables
+    int iStart;
+    int iStop;
+
+    // "-- Host: 192.168.0.42    Database: mcpdb"
+    iStart = this->qbaHead.indexOf ("Host:");
+    if ((this->qstrHost.isEmpty () == false) || (iStart < 0))
+    {
+        return;
+    }
+
+    iStart += 5;
+    while ((iStart < this->qbaHead.size ()) && (isspace ((unsigned char) this->qbaHead [iStart]) != 0))
+    {
+        iStart++;
+    }
+
+    iStop = iStart;
+    while ((iStop < this->qbaHead.size ()) && (isspace ((unsigned char) this->qbaHead [iStop]) == 0))
+    {
+        iStop++;
+    }
+
+    this->qstrHost = QString::fromUtf8 (this->qbaHead.mid (iStart, iStop - iStart));
+}
+
+
+void SqlDumpReader::startField (void)
+{
+    this->bToken    = false;
+    this->pqbaField = NULL;
+
+    if (this->bCapture == true)
+    {
+        if (this->iField == this->aiColumns [0])
+        {
+            this->pqbaField = &this->sCurrent.qbaComponent;
+        }
+        else if (this->iField == this->aiColumns [1])
+        {
+            this->pqbaField = &this->sCurrent.qbaTimeStamp;
+        }
+        else if (this->iField == this->aiColumns [2])
+        {
+            this->pqbaField = &this->sCurrent.qbaMessage;
+        }
+    }
+}
+
+
+void SqlDumpReader::endField (void)
+{
+    if ((this->bToken == false) || (this->pqbaField == NULL))
+    {
+        return;
+    }
+
+    if (this->pqbaField->toUpper () == "NULL")
+    {
+        this->pqbaField->clear ();
+    }
+    else if (this->pqbaField->startsWith ("0x") || this->pqbaField->startsWith ("0X"))
+    {
+        *this->pqbaField = QByteArray::fromHex (this->pqbaField->mid (2));
+    }
+}
+
+
+bool SqlDumpReader::nextRow (sSqlDumpRow_t& sRow)
+{
+    // declaration of variables
+    const char* pcData;
+    const char* pcQuote;
+    const char* pcStop;
+    char        cChar;
+    int         iStart;
+
+    while (true)
+    {
+        if ((this->iPos >= this->iBlockSize) && (this->readBlock () == false))
+        {
+            if ((this->qstrError.isEmpty () == true) &&
+                (((this->eState != STATE_STATEMENT) && (this->eState != STATE_LINE_COMMENT)) ||
+                 (this->qbaHead.trimmed ().isEmpty () == false)))
+            {
+                this->qstrError = "the dump ends inside a statement, the file is incomplete";
+            }
+            return (false);
+        }
+
+        pcData  = this->qbaBlock.constData ();
+        pcQuote = NULL;
+
+        while (this->iPos < this->iBlockSize)
+        {
+            cChar = pcData [this->iPos];
+
+            switch (this->eState)
+            {
+                case STATE_STATEMENT:
+                    this->iPos++;
+
+                    if ((this->qbaHead.isEmpty () == true) && (isspace ((unsigned char) cChar) != 0))
+                    {
+                        break;
+                    }
+
+                    if (cChar == ';')
+                    {
+                        this->parseStatement ();
+                        this->qbaHead.clear ();
+                        this->bHeadOverflow = false;
+                        break;
+                    }
+
+                    // "VALUES (" starts the first row of an INSERT statement
+                    if ((cChar == '(') && (this->bHeadOverflow == false) &&
+                        (this->qbaHead.trimmed ().toUpper ().endsWith (" VALUES") == true) &&
+                        ((this->qbaHead.toUpper ().startsWith ("INSERT") == true) || (this->qbaHead.toUpper ().startsWith ("REPLACE") == true)))
+                    {
+                        this->parseInsert ();
+                        this->qbaHead.clear ();
+                        this->eState = STATE_ROWS;
+                        this->iPos--;
+                        break;
+                    }
+
+                    if (this->qbaHead.size () < C_SQL_DUMP_MAX_HEAD)
+                    {
+                        this->qbaHead.append (cChar);
+                    }
+                    else
+                    {
+                        this->bHeadOverflow = true;
+                    }
+
+                    if ((this->qbaHead == "#") || (this->qbaHead == "--"))
+                    {
+                        this->eState = STATE_LINE_COMMENT;
+                    }
+                    else if ((cChar == '\'') || (cChar == '"') || (cChar == '`'))
+                    {
+                        this->cQuote = cChar;
+                        this->eState = STATE_HEAD_QUOTE;
+                    }
+                    break;
+
+                case STATE_HEAD_QUOTE:
+                case STATE_HEAD_ESCAPE:
+                    this->iPos++;
+
+                    if (this->qbaHead.size () < C_SQL_DUMP_MAX_HEAD)
+                    {
+                        this->qbaHead.append (cChar);
+                    }
+                    else
+                    {
+                        this->bHeadOverflow = true;
+                    }
+
+                    if (this->eState == STATE_HEAD_ESCAPE)
+                    {
+                        this->eState = STATE_HEAD_QUOTE;
+                    }
+                    else if ((cChar == '\\') && (this->cQuote != '`'))
+                    {
+                        this->eState = STATE_HEAD_ESCAPE;
+                    }
+                    else if (cChar == this->cQuote)
+                    {
+                        this->eState = STATE_STATEMENT;
+                    }
+                    break;
+
+                case STATE_LINE_COMMENT:
+                    this->iPos++;
+
+                    if (cChar == '\n')
+                    {
+                        this->parseComment ();
+                        this->qbaHead.clear ();
+                        this->bHeadOverflow = false;
+                        this->eState        = STATE_STATEMENT;
+                    }
+                    else if (this->qbaHead.size () < C_SQL_DUMP_MAX_HEAD)
+                    {
+                        this->qbaHead.append (cChar);
+                    }
+                    break;
+
+                case STATE_ROWS:
+                    this->iPos++;
+
+                    if (cChar == '(')
+                    {
+                        this->sCurrent.qbaComponent.clear ();
+                        this->sCurrent.qbaTimeStamp.clear ();
+                        this->sCurrent.qbaMessage.clear ();
+                        this->iField = 0;
+                        this->startField ();
+                        this->eState = STATE_FIELD_START;
+                    }
+                    else if (cChar == ';')
+                    {
+                        this->bCapture = false;
+                        this->eState   = STATE_STATEMENT;
+                    }
+                    break;
+
+                case STATE_FIELD_START:
+                    if (cChar == '\'')
+                    {
+                        this->iPos++;
+                        this->eState = STATE_STRING;
+                    }
+                    else if ((cChar == ',') || (cChar == ')'))
+                    {
+                        this->eState = STATE_FIELD_END;
+                    }
+                    else if (isspace ((unsigned char) cChar) != 0)
+                    {
+                        this->iPos++;
+                    }
+                    else
+                    {
+                        this->bToken = true;
+                        this->eState = STATE_TOKEN;
+                    }
+                    break;
+
+                case STATE_STRING:
+                    // the plain part of the string is copied (or skipped) at once
+                    // the next quote is searched only once for all escapes in front of it
+                    iStart = this->iPos;
+                    if ((pcQuote == NULL) || (pcQuote < pcData + iStart))
+                    {
+                        pcQuote = (const char*) memchr (pcData + iStart, '\'', this->iBlockSize - iStart);
+                        if (pcQuote == NULL)
+                        {
+                            pcQuote = pcData + this->iBlockSize;
+                        }
+                    }
+                    pcStop = (const char*) memchr (pcData + iStart, '\\', pcQuote - (pcData + iStart));
+                    if (pcStop == NULL)
+                    {
+                        pcStop = pcQuote;
+                    }
+                    this->iPos = (int) (pcStop - pcData);
+
+                    if (this->pqbaField != NULL)
+                    {
+                        this->pqbaField->append (pcData + iStart, this->iPos - iStart);
+                    }
+
+                    if (this->iPos < this->iBlockSize)
+                    {
+                        this->eState = (pcData [this->iPos] == '\\') ? STATE_ESCAPE : STATE_STRING_QUOTE;
+                        this->iPos++;
+                    }
+                    break;
+
+                case STATE_ESCAPE:
+                    this->iPos++;
+
+                    if (this->pqbaField != NULL)
+                    {
+                        switch (cChar)
+                        {
+                            case '0': this->pqbaField->append ('\0');   break;
+                            case 'b': this->pqbaField->append ('\b');   break;
+                            case 'n': this->pqbaField->append ('\n');   break;
+                            case 'r': this->pqbaField->append ('\r');   break;
+                            case 't': this->pqbaField->append ('\t');   break;
+                            case 'Z': this->pqbaField->append ('\x1A'); break;
+                            default:  this->pqbaField->append (cChar);  break;
+                        }
+                    }
+                    this->eState = STATE_STRING;
+                    break;
+
+                case STATE_STRING_QUOTE:
+                    // doubled quote inside the string
+                    if (cChar == '\'')
+                    {
+                        this->iPos++;
+                        if (this->pqbaField != NULL)
+                        {
+                            this->pqbaField->append (cChar);
+                        }
+                        this->eState = STATE_STRING;
+                    }
+                    else
+                    {
+                        this->eState = STATE_FIELD_END;
+                    }
+                    break;
+
+                case STATE_TOKEN:
+                    if ((cChar == ',') || (cChar == ')') || (cChar == '\'') || (isspace ((unsigned char) cChar) != 0))
+                    {
+                        this->endField ();
+                        this->eState = STATE_FIELD_END;
+                    }
+                    else
+                    {
+                        this->iPos++;
+                        if (this->pqbaField != NULL)
+                        {
+                            this->pqbaField->append (cChar);
+                        }
+                    }
+                    break;
+
+                case STATE_FIELD_END:
+                    this->iPos++;
+
+                    if (cChar == '\'')
+                    {
+                        // character set introducer (e.g. _binary 'value') or concatenated string
+                        if ((this->bToken == true) && (this->pqbaField != NULL))
+                        {
+                            this->pqbaField->clear ();
+                        }
+                        this->bToken = false;
+                        this->eState = STATE_STRING;
+                    }
+                    else if (cChar == ',')
+                    {
+                        this->iField++;
+                        this->startField ();
+                        this->eState = STATE_FIELD_START;
+                    }
+                    else if (cChar == ')')
+                    {
+                        this->eState = STATE_ROWS;
+
+                        if (this->bCapture == true)
+                        {
+                            this->lliNumRows++;
+                            sRow.qbaComponent.swap (this->sCurrent.qbaComponent);
+                            sRow.qbaTimeStamp.swap (this->sCurrent.qbaTimeStamp);
+                            sRow.qbaMessage.swap   (this->sCurrent.qbaMessage);
+                            return (true);
+                        }
+                    }
+                    break;
+            }
+        }
+    }
+}
+
+
+QString SqlDumpReader::host (void) const
+{
+    return (this->qstrHost);
+}
+
+
+QString SqlDumpReader::errorString (void) const
+{
+    return (this->qstrError);
+}
+
+
+qint64 SqlDumpReader::numRows (void) const
+{
+    return (this->lliNumRows);
+}
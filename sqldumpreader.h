@@ -0,0 +1,258 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file sqldumpreader.h
+ *
+ * \brief contains the defintion of the SqlDumpReader class.
+ *
+ * ---
+ */
+
+
+#ifndef SQLDUMPREADER_H
+#define SQLDUMPREADER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+
+#define C_SQL_DUMP_READER_NAME "SqlDumpReader"
+
+
+/**
+ * names of the columns of the log table, that are extracted from the dump.
+ */
+#define C_SQL_DUMP_COLUMN_COMPONENT "component"
+#define C_SQL_DUMP_COLUMN_TIMESTAMP "timestamp"
+#define C_SQL_DUMP_COLUMN_MESSAGE   "message"
+
+
+/**
+ * \brief one row of the log table, as written in the dump (unescaped, NULL is empty).
+ */
+typedef struct
+{
+    QByteArray qbaComponent;    ///< component column
+    QByteArray qbaTimeStamp;    ///< timestamp column
+    QByteArray qbaMessage;      ///< message column (XML)
+} sSqlDumpRow_t;
+
+
+/**
+ * \class SqlDumpReader
+ *
+ * \brief Tokenises the INSERT statements of one table inside a mysqldump file.
+ *
+ * The dump is read block by block from the device and scanned by a state machine,
+ * hence neither the file nor a single extended INSERT statement is ever held in
+ * memory. Only the wanted columns of the wanted table are copied, the values of all
+ * other columns and tables are skipped while scanning. The column order is taken
+ * from the column list of the INSERT statement (mysqldump --complete-insert) or
+ * from the CREATE TABLE statement of the table.
+ * String values are unescaped (backslash escapes and doubled quotes), _binary
+ * prefixes are removed and hex values (mysqldump --hex-blob) are decoded.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class SqlDumpReader
+{
+    private:
+        /**
+         * states of the tokeniser.
+         */
+        typedef enum
+        {
+            STATE_STATEMENT    = 0,     ///< head of a statement
+            STATE_HEAD_QUOTE   = 1,     ///< quoted string or identifier inside the head
+            STATE_HEAD_ESCAPE  = 2,     ///< escaped character inside the head
+            STATE_LINE_COMMENT = 3,     ///< "--" or "#" comment
+            STATE_ROWS         = 4,     ///< between the rows of an INSERT statement
+            STATE_FIELD_START  = 5,     ///< before a value
+            STATE_STRING       = 6,     ///< quoted value
+            STATE_ESCAPE       = 7,     ///< escaped character inside a quoted value
+            STATE_STRING_QUOTE = 8,     ///< quote inside a quoted value (end or doubled quote)
+            STATE_TOKEN        = 9,     ///< unquoted value (number, NULL, hex value)
+            STATE_FIELD_END    = 10     ///< after a value
+        } eState_t;
+
+        QIODevice* pclDevice;
+
+        /**
+         * block, that is currently scanned, and scan position inside it.
+         */
+        QByteArray qbaBlock;
+        int        iBlockSize;
+        int        iPos;
+        bool       bEndOfFile;
+
+        /**
+         * state of the tokeniser, quote character of the current quoted string, head
+         * of the current statement and true, if the head got too long to be kept.
+         */
+        eState_t   eState;
+        char       cQuote;
+        QByteArray qbaHead;
+        bool       bHeadOverflow;
+
+        /**
+         * wanted table, its columns from the CREATE TABLE statement and the positions
+         * of component, timestamp and message inside the rows of the current statement
+         * (-1: column not available).
+         */
+        QByteArray          qbaTable;
+        QVector<QByteArray> qvecTableColumns;
+        int                 aiColumns [3];
+        bool                bCapture;
+
+        /**
+         * current row: index of the current value, value buffer (NULL: the value is
+         * skipped) and true, if the current value is unquoted.
+         */
+        sSqlDumpRow_t sCurrent;
+        int           iField;
+        QByteArray*   pqbaField;
+        bool          bToken;
+
+        QString qstrHost;
+        QString qstrError;
+        qint64  lliNumRows;
+
+        /**
+         * \brief Reads the next block from the device.
+         *
+         * \return bool = true: OK / false: end of the file or read error
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool readBlock (void);
+
+        /**
+         * \brief Evaluates a complete statement, that is not an INSERT statement.
+         *
+         * The column names are taken from the CREATE TABLE statement of the wanted table.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void parseStatement (void);
+
+        /**
+         * \brief Evaluates the head of an INSERT statement up to VALUES.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void parseInsert (void);
+
+        /**
+         * \brief Evaluates a comment line (host name of the dump header).
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void parseComment (void);
+
+        /**
+         * \brief Selects the buffer of the current value.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void startField (void);
+
+        /**
+         * \brief Converts the current unquoted value (NULL, hex value).
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void endField (void);
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] QIODevice* pclDeviceRef = opened device, needs to stay valid while reading
+         * @param[in] const QByteArray& qbaTableName = name of the table, that is read
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        SqlDumpReader (QIODevice* pclDeviceRef, const QByteArray& qbaTableName = "log");
+
+        /**
+         * \brief Returns the next row of the table.
+         *
+         * @param[out] sSqlDumpRow_t& sRow = next row
+         * \return bool = true: OK / false: end of the dump or error (see errorString ())
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool nextRow (sSqlDumpRow_t& sRow);
+
+        /**
+         * \brief Returns the host name from the header of the dump.
+         *
+         * \return QString = host name / empty string: the dump has no header (yet)
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QString host (void) const;
+
+        /**
+         * \brief Returns the error, that has stopped reading or that made rows unreadable.
+         *
+         * \return QString = error text / empty string: no error
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QString errorString (void) const;
+
+        /**
+         * \brief Returns the number of rows of the table, that have been read.
+         *
+         * \return qint64 = number of rows
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        qint64 numRows (void) const;
+};
+
+#endif // SQLDUMPREADER_H
@@ -0,0 +1,172 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file stateintervals.cpp
+ *
+ * \brief contains the implementation of the StateIntervals class.
+ *
+ * ---
+ */
+
+
+#include "stateintervals.h"
+
+#include <cmath>
+
+
+StateIntervals::StateIntervals (const QString& qstrChannelRef, const qint64 lliMaxGapSecondsValue)
+{
+    this->qstrChannel      = qstrChannelRef;
+    this->lliMaxGapSeconds = qMax (lliMaxGapSecondsValue, (qint64) 1);
+
+    this->reset ();
+}
+
+
+void StateIntervals::reset (void)
+{
+    this->qvecIntervals.clear ();
+    this->bOpen       = false;
+    this->uiContentId = 0;
+    this->iNumRows    = 0;
+}
+
+
+void StateIntervals::addSample (const qint64 tTimeStamp, const double dValue)
+{
+    // declaration of variables
+    sStateInterval_t sInterval;
+
+    if ((this->qvecIntervals.isEmpty () == false) && (tTimeStamp < this->qvecIntervals.last ().tStop))
+    {
+        return;
+    }
+
+    // invalid samples end the current interval
+    if (std::isnan (dValue) == true)
+    {
+        this->bOpen = false;
+        return;
+    }
+
+    sInterval.tStart = tTimeStamp;
+    sInterval.tStop  = tTimeStamp;
+    sInterval.iState = (int) std::lround (dValue);
+
+    if ((this->bOpen == true) && ((tTimeStamp - this->qvecIntervals.last ().tStop) <= this->lliMaxGapSeconds))
+    {
+        // the current interval lasts until this sample
+        this->qvecIntervals.last ().tStop = tTimeStamp;
+        if (this->qvecIntervals.last ().iState != sInterval.iState)
+        {
+            this->qvecIntervals.push_back (sInterval);
+        }
+    }
+    else
+    {
+        this->qvecIntervals.push_back (sInterval);
+    }
+
+    this->bOpen = true;
+}
+
+
+void StateIntervals::update (const TelemetrySeries& clSeries)
+{
+    // declaration of variables
+    const QVector<qint64>& qvecTimeStamps = clSeries.timeStamps ();
+    const QVector<double>& qvecValues     = clSeries.column (this->qstrChannel);
+    int                    iCounter;
+
+    if ((this->uiContentId != clSeries.contentId ()) || (this->iNumRows > clSeries.size ()))
+    {
+        this->reset ();
+        this->uiContentId = clSeries.contentId ();
+    }
+
+    if (qvecValues.isEmpty () == true)
+    {
+        return;
+    }
+
+    for (iCounter = this->iNumRows; iCounter < clSeries.size (); iCounter++)
+    {
+        this->addSample (qvecTimeStamps [iCounter], qvecValues [iCounter]);
+    }
+    this->iNumRows = clSeries.size ();
+}
+
+
+const QVector<sStateInterval_t>& StateIntervals::intervals (void) const
+{
+    return (this->qvecIntervals);
+}
+
+
+QVector<sStateInterval_t> StateIntervals::intervalsBelow (const double dThreshold) const
+{
+    // declaration of variables
+    QVector<sStateInterval_t> qvecResult;
+
+    for (const sStateInterval_t& sInterval : this->qvecIntervals)
+    {
+        if (sInterval.iState < dThreshold)
+        {
+            if ((qvecResult.isEmpty () == false) && (qvecResult.last ().tStop == sInterval.tStart))
+            {
+                qvecResult.last ().tStop  = sInterval.tStop;
+                qvecResult.last ().iState = qMin (qvecResult.last ().iState, sInterval.iState);
+            }
+            else
+            {
+                qvecResult.push_back (sInterval);
+            }
+        }
+    }
+
+    return (qvecResult);
+}
+
+
+qint64 StateIntervals::duration (const int iState) const
+{
+    // declaration of variables
+    qint64 lliDuration = 0;
+
+    for (const sStateInterval_t& sInterval : this->qvecIntervals)
+    {
+        if (sInterval.iState == iState)
+        {
+            lliDuration += sInterval.tStop - sInterval.tStart;
+        }
+    }
+
+    return (lliDuration);
+}
@@ -0,0 +1,181 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file stateintervals.h
+ *
+ * \brief contains the defintion of the StateIntervals class.
+ *
+ * ---
+ */
+
+
+#ifndef STATEINTERVALS_H
+#define STATEINTERVALS_H
+
+#include <QString>
+#include <QVector>
+
+#include "telemetrystore.h"
+
+
+/**
+ * interval, during which a state channel had the same value.
+ */
+typedef struct
+{
+    qint64 tStart;      ///< timestamp of the first sample of the interval
+    qint64 tStop;       ///< timestamp of the first sample of the next state / last sample before a gap
+    int    iState;      ///< state value
+} sStateInterval_t;
+
+
+/**
+ * \class StateIntervals
+ *
+ * \brief Run length encoding of a state channel (e.g. sync_state, num_sats).
+ *
+ * Consecutive samples with the same (rounded) value are stored as one interval.
+ * The intervals are extended incrementally while the rows of the series are
+ * appended. Intervals end at gaps longer than the max. gap length and at invalid
+ * (NaN) samples. Queries work on the intervals only, hence their cost depends on
+ * the number of state changes and not on the number of samples.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class StateIntervals
+{
+    private:
+        /**
+         * name of the state channel.
+         */
+        QString qstrChannel;
+
+        /**
+         * max. distance of two samples, that belong to the same interval.
+         */
+        qint64 lliMaxGapSeconds;
+
+        /**
+         * intervals, the last one is extended by new samples, as long as it is open.
+         */
+        QVector<sStateInterval_t> qvecIntervals;
+        bool                      bOpen;
+
+        /**
+         * series, that is tracked by update (), and number of processed rows.
+         */
+        quint64 uiContentId;
+        int     iNumRows;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const QString& qstrChannelRef = name of the state channel
+         * @param[in] const qint64 lliMaxGapSecondsValue = max. distance of two samples inside an interval [s]
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        StateIntervals (const QString& qstrChannelRef, const qint64 lliMaxGapSecondsValue = 900);
+
+        /**
+         * \brief Adds one sample.
+         *
+         * The samples need to be added in time order, older samples are ignored.
+         *
+         * @param[in] const qint64 tTimeStamp = timestamp in epoch seconds
+         * @param[in] const double dValue = value of the state channel
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void addSample (const qint64 tTimeStamp, const double dValue);
+
+        /**
+         * \brief Adds the rows of a series, that have not been processed yet.
+         *
+         * If the series has been cleared since the last call, the intervals are reset.
+         *
+         * @param[in] const TelemetrySeries& clSeries = series, that contains the state channel
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void update (const TelemetrySeries& clSeries);
+
+        /**
+         * \brief Returns all intervals.
+         *
+         * \return const QVector<sStateInterval_t>& = intervals in time order
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const QVector<sStateInterval_t>& intervals (void) const;
+
+        /**
+         * \brief Returns the intervals, during which the state was below a threshold.
+         *
+         * Adjacent intervals are merged, e.g. sync_state < 1 returns the sync loss
+         * intervals, num_sats < 4 the intervals with too few satellites.
+         *
+         * @param[in] const double dThreshold = threshold
+         * \return QVector<sStateInterval_t> = merged intervals, iState is the min. state inside the interval
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QVector<sStateInterval_t> intervalsBelow (const double dThreshold) const;
+
+        /**
+         * \brief Returns the total duration of a state.
+         *
+         * @param[in] const int iState = state value
+         * \return qint64 = duration in seconds
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        qint64 duration (const int iState) const;
+
+        /**
+         * \brief Removes all intervals.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void reset (void);
+};
+
+#endif // STATEINTERVALS_H
@@ -0,0 +1,420 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file statusdecoder.h
+ *
+ * \brief contains the field descriptor tables and the decoder for the status messages.
+ *
+ * ---
+ */
+
+
+#ifndef STATUSDECODER_H
+#define STATUSDECODER_H
+
+#include <QString>
+#include <QStringView>
+#include <QDomNode>
+
+#include <ctime>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+#include "numberparser.h"
+#include "xmlparses.h"
+#include "timestampdecoder.h"
+
+
+/**
+ * HW_STATUS message.
+ */
+typedef struct
+{
+    double dBattVoltage;
+    double dBattCurr1;
+    double dBattCurr2;
+    double dTemperatureSystem;
+    double dTemperatureSensor;
+    time_t sTimeStamp;
+} sHWStatus_t;
+
+
+/**
+ * GPS_STATUS message.
+ */
+typedef struct
+{
+    double dNumSats;
+    double dSyncState;
+    time_t sTimeStamp;
+} sGPStatus_t;
+
+
+/**
+ * \brief computes the FNV-1a hash of a tag name at compile time.
+ */
+constexpr uint32_t statusTagHash (const char* pcTagName)
+{
+    uint32_t uiHash = 2166136261u;
+    while (*pcTagName != '\0')
+    {
+        uiHash = (uiHash ^ (uint8_t) *pcTagName) * 16777619u;
+        pcTagName++;
+    }
+    return (uiHash);
+}
+
+
+/**
+ * \brief computes the FNV-1a hash of a tag name at runtime.
+ *
+ * Returns 0, if the tag contains non ASCII characters (cannot match any table entry).
+ */
+inline uint32_t statusTagHash (const QStringView qsvTagName)
+{
+    uint32_t uiHash = 2166136261u;
+    for (const QChar clChar : qsvTagName)
+    {
+        if (clChar.unicode () > 0x7F)
+        {
+            return (0);
+        }
+        uiHash = (uiHash ^ (uint8_t) clChar.unicode ()) * 16777619u;
+    }
+    return (uiHash);
+}
+
+
+/**
+ * \brief compares a tag name with the name of a table entry.
+ */
+inline bool statusTagEqual (const QStringView qsvTagName, const char* pcTagName)
+{
+    int iCounter;
+    for (iCounter = 0; iCounter < qsvTagName.size (); iCounter++)
+    {
+        if ((pcTagName [iCounter] == '\0') || (qsvTagName [iCounter].unicode () != (uint8_t) pcTagName [iCounter]))
+        {
+            return (false);
+        }
+    }
+    return (pcTagName [iCounter] == '\0');
+}
+
+
+/**
+ * \brief describes one field of a status message.
+ *
+ * The node value is converted to double and divided by the scale factor before
+ * it is stored inside the struct member.
+ */
+template <typename Message>
+struct sStatusField_t
+{
+    const char*     pcTagName;      ///< XML tag name of the field
+    double Message::*pdMember;      ///< struct member the value is stored in
+    double          dScale;         ///< node value is divided by this value
+    uint32_t        uiHash;         ///< hash of the tag name
+};
+
+
+/**
+ * \brief creates a table entry, the hash is computed at compile time.
+ */
+template <typename Message>
+constexpr sStatusField_t<Message> statusField (const char* pcTagName, double Message::*pdMember, const double dScale = 1.0)
+{
+    return (sStatusField_t<Message> {pcTagName, pdMember, dScale, statusTagHash (pcTagName)});
+}
+
+
+/**
+ * \brief field table of the HW_STATUS message.
+ */
+struct HWStatusTable
+{
+    typedef sHWStatus_t Message;
+
+    static constexpr const char* pcComponent = "HW_STATUS";
+
+    static constexpr sStatusField_t<sHWStatus_t> arsFields [] =
+    {
+        statusField ("temp",        &sHWStatus_t::dTemperatureSystem),
+        statusField ("temp_sensor", &sHWStatus_t::dTemperatureSensor),
+        statusField ("batt_volt",   &sHWStatus_t::dBattVoltage,  10.0),
+        statusField ("batt1_curr",  &sHWStatus_t::dBattCurr1,   100.0),
+        statusField ("batt2_curr",  &sHWStatus_t::dBattCurr2,   100.0)
+    };
+};
+
+
+/**
+ * \brief field table of the GPS_STATUS message.
+ */
+struct GPStatusTable
+{
+    typedef sGPStatus_t Message;
+
+    static constexpr const char* pcComponent = "GPS_STATUS";
+
+    static constexpr sStatusField_t<sGPStatus_t> arsFields [] =
+    {
+        statusField ("num_sats",   &sGPStatus_t::dNumSats),
+        statusField ("sync_state", &sGPStatus_t::dSyncState)
+    };
+};
+
+
+/**
+ * \class StatusDecoder
+ *
+ * \brief This class decodes status messages based on a field descriptor table.
+ *
+ * The decoder is generated from the table at compile time. The tag name of each
+ * node is hashed once and compared against the constant hashes of the table
+ * entries, hence the tag matching compiles into a fixed sequence of integer
+ * compares without any string lookups. Adding a field to a table does not add
+ * any runtime overhead for the other fields.
+ * Besides the table fields the decoder always reads the "date" and "time" fields
+ * and converts them into the message timestamp.
+ *
+ * The decoder can be fed node by node (beginMessage(), addField(), endMessage())
+ * or directly with the DOM node of a message (decode()). If a field exists more
+ * than once, the first one in document order is used.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+template <typename Table>
+class StatusDecoder
+{
+    public:
+        typedef typename Table::Message Message;
+
+    private:
+        static constexpr int iNumFields = (int) std::size (Table::arsFields);
+        static constexpr int iDateIndex = iNumFields;
+        static constexpr int iTimeIndex = iNumFields + 1;
+
+        static_assert (iNumFields <= 62, "too many fields inside status table");
+
+        /**
+         * message that is currently decoded.
+         */
+        Message sMsg;
+
+        /**
+         * bit mask of the fields that have already been found.
+         */
+        uint64_t ui64Found;
+
+        /**
+         * date and time field of the current message.
+         */
+        QString qstrDate;
+        QString qstrTime;
+
+        /**
+         * cache for the timestamp conversion.
+         */
+        TimestampDecoder clTimeDecoder;
+
+        /**
+         * \brief returns the table index of the tag, date / time index or -1 if unknown.
+         */
+        template <std::size_t... Index>
+        static int matchField (const uint32_t uiHash, const QStringView qsvTagName, std::index_sequence<Index...>)
+        {
+            int iIndex = -1;
+
+            (void) (((uiHash == Table::arsFields [Index].uiHash) &&
+                     (statusTagEqual (qsvTagName, Table::arsFields [Index].pcTagName) == true) &&
+                     ((iIndex = (int) Index), true)) || ...);
+
+            if (iIndex < 0)
+            {
+                if ((uiHash == statusTagHash ("date")) && (statusTagEqual (qsvTagName, "date") == true))
+                {
+                    iIndex = iDateIndex;
+                }
+                else if ((uiHash == statusTagHash ("time")) && (statusTagEqual (qsvTagName, "time") == true))
+                {
+                    iIndex = iTimeIndex;
+                }
+            }
+
+            return (iIndex);
+        }
+
+        /**
+         * \brief returns true, if all table fields and date / time have been found.
+         */
+        bool isComplete (void) const
+        {
+            return (this->ui64Found == ((Q_UINT64_C (1) << (iNumFields + 2)) - 1));
+        }
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        StatusDecoder (void)
+        {
+            this->beginMessage ();
+        }
+
+        /**
+         * \brief Returns the component name of the messages decoded by this decoder.
+         *
+         * ---
+         *
+         * \return const char* = component name, e.g. "HW_STATUS"
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static const char* component (void)
+        {
+            return (Table::pcComponent);
+        }
+
+        /**
+         * \brief Starts decoding of a new message.
+         *
+         * All fields are set to 0.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void beginMessage (void)
+        {
+            this->sMsg = Message ();
+            this->ui64Found = 0;
+            this->qstrDate.clear ();
+            this->qstrTime.clear ();
+        }
+
+        /**
+         * \brief Feeds one node of the message into the decoder.
+         *
+         * Unknown tags and duplicated fields are ignored.
+         *
+         * @param[in] const QStringView qsvTagName = tag name of the node
+         * @param[in] const QString& qstrValue = node value
+         * \return bool = true: all fields of the message have been found / false: more fields expected
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool addField (const QStringView qsvTagName, const QString& qstrValue)
+        {
+            // declaration of variables
+            int iIndex = matchField (statusTagHash (qsvTagName), qsvTagName, std::make_index_sequence<iNumFields> ());
+
+            if ((iIndex >= 0) && ((this->ui64Found & (Q_UINT64_C (1) << iIndex)) == 0))
+            {
+                this->ui64Found |= (Q_UINT64_C (1) << iIndex);
+
+                if (iIndex == iDateIndex)
+                {
+                    this->qstrDate = qstrValue;
+                }
+                else if (iIndex == iTimeIndex)
+                {
+                    this->qstrTime = qstrValue;
+                }
+                else
+                {
+                    const sStatusField_t<Message>& sField = Table::arsFields [iIndex];
+
+                    NumberParser::toDouble (qstrValue, this->sMsg.*(sField.pdMember));
+                    this->sMsg.*(sField.pdMember) /= sField.dScale;
+                }
+            }
+
+            return (this->isComplete ());
+        }
+
+        /**
+         * \brief Finishes decoding of the message.
+         *
+         * Converts the timestamp and returns the message.
+         *
+         * @param[out] Message& sMessage = decoded message
+         * \return bool = true: OK / false: missing or malformed timestamp
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool endMessage (Message& sMessage)
+        {
+            // declaration of variables
+            bool bRetValue;
+
+            bRetValue = this->clTimeDecoder.decode (this->qstrDate, this->qstrTime, this->sMsg.sTimeStamp);
+            sMessage  = this->sMsg;
+
+            return (bRetValue);
+        }
+
+        /**
+         * \brief Decodes a complete message from its DOM node.
+         *
+         * Walks all nodes below the message node once in document order.
+         *
+         * @param[in] const QDomNode& clMessage = message node (or document)
+         * @param[out] Message& sMessage = decoded message
+         * \return bool = true: OK / false: missing or malformed timestamp
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool decode (const QDomNode& clMessage, Message& sMessage)
+        {
+            this->beginMessage ();
+
+            // the walk stops, as soon as all fields of the table have been read
+            XMLParser::walkSubNodes (clMessage, [this] (const QDomNode& clNode)
+            {
+                return (this->addField (clNode.nodeName (), clNode.firstChild ().nodeValue ()));
+            });
+
+            return (this->endMessage (sMessage));
+        }
+};
+
+#endif // STATUSDECODER_H
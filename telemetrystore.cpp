@@ -0,0 +1,586 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file telemetrystore.cpp
+ *
+ * \brief contains the implementation of the TelemetrySeries and TelemetryStore classes.
+ *
+ * ---
+ */
+
+
+#include "telemetrystore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+
+/**
+ * \brief returns a new, unique content id for a series.
+ */
+static quint64 nextContentId (void)
+{
+    static std::atomic<quint64> uiNextId (1);
+
+    return (uiNextId++);
+}
+
+
+const qint64 TelemetrySeries::alliTierSeconds [TelemetrySeries::iNumTiers] = {60, 3600, 86400};
+
+
+TelemetryTier::TelemetryTier (const qint64 lliBucketSecondsValue)
+{
+    this->lliBucketSeconds = qMax (lliBucketSecondsValue, (qint64) 1);
+}
+
+
+qint64 TelemetryTier::bucketSeconds (void) const
+{
+    return (this->lliBucketSeconds);
+}
+
+
+int TelemetryTier::size (void) const
+{
+    return (this->qvecTimeStamps.size ());
+}
+
+
+const QVector<qint64>& TelemetryTier::timeStamps (void) const
+{
+    return (this->qvecTimeStamps);
+}
+
+
+const QVector<double>& TelemetryTier::minimum (const int iChannel) const
+{
+    // declaration of variables
+    static const QVector<double> qvecEmpty;
+
+    if ((iChannel < 0) || (iChannel >= this->qvecMin.size ()))
+    {
+        return (qvecEmpty);
+    }
+
+    return (this->qvecMin [iChannel]);
+}
+
+
+const QVector<double>& TelemetryTier::mean (const int iChannel) const
+{
+    // declaration of variables
+    static const QVector<double> qvecEmpty;
+
+    if ((iChannel < 0) || (iChannel >= this->qvecMean.size ()))
+    {
+        return (qvecEmpty);
+    }
+
+    return (this->qvecMean [iChannel]);
+}
+
+
+const QVector<double>& TelemetryTier::maximum (const int iChannel) const
+{
+    // declaration of variables
+    static const QVector<double> qvecEmpty;
+
+    if ((iChannel < 0) || (iChannel >= this->qvecMax.size ()))
+    {
+        return (qvecEmpty);
+    }
+
+    return (this->qvecMax [iChannel]);
+}
+
+
+void TelemetryTier::addChannel (void)
+{
+    // declaration of variables
+    const double dNaN = std::numeric_limits<double>::quiet_NaN ();
+
+    this->qvecMin.push_back  (QVector<double> (this->qvecTimeStamps.size (), dNaN));
+    this->qvecMean.push_back (QVector<double> (this->qvecTimeStamps.size (), dNaN));
+    this->qvecMax.push_back  (QVector<double> (this->qvecTimeStamps.size (), dNaN));
+    this->qvecSum.push_back   (0.0);
+    this->qvecCount.push_back (0);
+}
+
+
+bool TelemetryTier::appendRow (const qint64 tTimeStamp, const QVector<QVector<double> >& qvecColumns, const int iRow)
+{
+    // declaration of variables
+    const double dNaN = std::numeric_limits<double>::quiet_NaN ();
+    qint64       tBucket;
+    int          iCounter;
+    double       dValue;
+
+    // floor division, also for timestamps before 1970
+    tBucket = tTimeStamp / this->lliBucketSeconds;
+    if ((tTimeStamp % this->lliBucketSeconds) < 0)
+    {
+        tBucket--;
+    }
+    tBucket *= this->lliBucketSeconds;
+
+    if ((this->qvecTimeStamps.isEmpty () == false) && (tBucket < this->qvecTimeStamps.last ()))
+    {
+        return (false);
+    }
+
+    if ((this->qvecTimeStamps.isEmpty () == true) || (tBucket > this->qvecTimeStamps.last ()))
+    {
+        this->qvecTimeStamps.push_back (tBucket);
+        for (iCounter = 0; iCounter < this->qvecMean.size (); iCounter++)
+        {
+            this->qvecMin   [iCounter].push_back (dNaN);
+            this->qvecMean  [iCounter].push_back (dNaN);
+            this->qvecMax   [iCounter].push_back (dNaN);
+            this->qvecSum   [iCounter] = 0.0;
+            this->qvecCount [iCounter] = 0;
+        }
+    }
+
+    for (iCounter = 0; iCounter < qMin (this->qvecMean.size (), qvecColumns.size ()); iCounter++)
+    {
+        dValue = qvecColumns [iCounter][iRow];
+        if (std::isnan (dValue) == false)
+        {
+            if (this->qvecCount [iCounter] == 0)
+            {
+                this->qvecMin [iCounter].last () = dValue;
+                this->qvecMax [iCounter].last () = dValue;
+            }
+            else
+            {
+                this->qvecMin [iCounter].last () = qMin (this->qvecMin [iCounter].last (), dValue);
+                this->qvecMax [iCounter].last () = qMax (this->qvecMax [iCounter].last (), dValue);
+            }
+
+            this->qvecSum   [iCounter] += dValue;
+            this->qvecCount [iCounter]++;
+            this->qvecMean  [iCounter].last () = this->qvecSum [iCounter] / this->qvecCount [iCounter];
+        }
+    }
+
+    return (true);
+}
+
+
+void TelemetryTier::reset (const int iNumChannels)
+{
+    // declaration of variables
+    int iCounter;
+
+    this->qvecTimeStamps.clear ();
+    this->qvecMin.clear   ();
+    this->qvecMean.clear  ();
+    this->qvecMax.clear   ();
+    this->qvecSum.clear   ();
+    this->qvecCount.clear ();
+
+    for (iCounter = 0; iCounter < iNumChannels; iCounter++)
+    {
+        this->addChannel ();
+    }
+}
+
+
+TelemetrySeries::TelemetrySeries (const QString& qstrComponentRef)
+{
+    // declaration of variables
+    int iCounter;
+
+    this->qstrComponent = qstrComponentRef;
+    this->bTiersDirty   = false;
+    this->bTimeOrdered  = true;
+    this->tMinTimeStamp = 0;
+    this->tMaxTimeStamp = 0;
+    this->uiContentId   = nextContentId ();
+
+    for (iCounter = 0; iCounter < TelemetrySeries::iNumTiers; iCounter++)
+    {
+        this->qvecTiers.push_back (TelemetryTier (TelemetrySeries::alliTierSeconds [iCounter]));
+    }
+}
+
+
+const QString& TelemetrySeries::component (void) const
+{
+    return (this->qstrComponent);
+}
+
+
+int TelemetrySeries::size (void) const
+{
+    return (this->qvecTimeStamps.size ());
+}
+
+
+const QVector<QString>& TelemetrySeries::channelNames (void) const
+{
+    return (this->qvecChannelNames);
+}
+
+
+int TelemetrySeries::channelIndex (const QString& qstrChannel) const
+{
+    return (this->qhashChannelIndex.value (qstrChannel, -1));
+}
+
+
+int TelemetrySeries::addChannel (const QString& qstrChannel)
+{
+    // declaration of variables
+    int iIndex = this->channelIndex (qstrChannel);
+
+    if (iIndex < 0)
+    {
+        iIndex = this->qvecChannelNames.size ();
+        this->qvecChannelNames.push_back (qstrChannel);
+        this->qvecColumns.push_back (QVector<double> (this->qvecTimeStamps.size (), std::numeric_limits<double>::quiet_NaN ()));
+        this->qhashChannelIndex.insert (qstrChannel, iIndex);
+
+        for (TelemetryTier& clTier : this->qvecTiers)
+        {
+            clTier.addChannel ();
+        }
+    }
+
+    return (iIndex);
+}
+
+
+const QVector<qint64>& TelemetrySeries::timeStamps (void) const
+{
+    return (this->qvecTimeStamps);
+}
+
+
+bool TelemetrySeries::timeRange (qint64& tFirst, qint64& tLast) const
+{
+    tFirst = this->tMinTimeStamp;
+    tLast  = this->tMaxTimeStamp;
+
+    return (this->qvecTimeStamps.isEmpty () == false);
+}
+
+
+quint64 TelemetrySeries::contentId (void) const
+{
+    return (this->uiContentId);
+}
+
+
+const QVector<double>& TelemetrySeries::column (const QString& qstrChannel) const
+{
+    // declaration of variables
+    static const QVector<double> qvecEmpty;
+    int iIndex = this->channelIndex (qstrChannel);
+
+    if (iIndex < 0)
+    {
+        return (qvecEmpty);
+    }
+
+    return (this->qvecColumns [iIndex]);
+}
+
+
+void TelemetrySeries::appendRecord (const sLogRecord_t& sRecord)
+{
+    // declaration of variables
+    int    iCounter;
+    int    iNumValues = qMin (sRecord.qvecChannels.size (), sRecord.qvecValues.size ());
+    qint64 tDay;
+
+    // rebuild column mapping, only if the decoder changed its channel list
+    if ((this->qvecLastChannels.constData () != sRecord.qvecChannels.constData ()) ||
+        (this->qvecLastChannels.size ()      != sRecord.qvecChannels.size ()))
+    {
+        this->qvecLastChannels = sRecord.qvecChannels;
+        this->qvecLastMapping.resize (sRecord.qvecChannels.size ());
+        for (iCounter = 0; iCounter < sRecord.qvecChannels.size (); iCounter++)
+        {
+            this->qvecLastMapping [iCounter] = this->addChannel (sRecord.qvecChannels [iCounter]);
+        }
+    }
+
+    this->qvecTimeStamps.push_back (sRecord.tTimeStamp);
+    for (iCounter = 0; iCounter < this->qvecColumns.size (); iCounter++)
+    {
+        this->qvecColumns [iCounter].push_back (std::numeric_limits<double>::quiet_NaN ());
+    }
+
+    for (iCounter = 0; iCounter < iNumValues; iCounter++)
+    {
+        this->qvecColumns [this->qvecLastMapping [iCounter]].last () = sRecord.qvecValues [iCounter];
+    }
+
+    if ((this->qvecTimeStamps.size () > 1) && (sRecord.tTimeStamp < this->qvecTimeStamps [this->qvecTimeStamps.size () - 2]))
+    {
+        this->bTimeOrdered = false;
+    }
+
+    this->tMinTimeStamp = (this->qvecTimeStamps.size () > 1) ? qMin (this->tMinTimeStamp, sRecord.tTimeStamp) : sRecord.tTimeStamp;
+    this->tMaxTimeStamp = (this->qvecTimeStamps.size () > 1) ? qMax (this->tMaxTimeStamp, sRecord.tTimeStamp) : sRecord.tTimeStamp;
+
+    // add the values to the quantile sketches of the day
+    tDay = sRecord.tTimeStamp / TelemetrySeries::lliSketchSeconds;
+    if ((sRecord.tTimeStamp % TelemetrySeries::lliSketchSeconds) < 0)
+    {
+        tDay--;
+    }
+
+    QVector<QuantileSketch>& qvecSketches = this->qmapDaySketches [tDay * TelemetrySeries::lliSketchSeconds];
+    if (qvecSketches.size () < this->qvecColumns.size ())
+    {
+        qvecSketches.resize (this->qvecColumns.size ());
+    }
+    for (iCounter = 0; iCounter < iNumValues; iCounter++)
+    {
+        qvecSketches [this->qvecLastMapping [iCounter]].add (sRecord.qvecValues [iCounter]);
+    }
+
+    // update the tiers incrementally, as long as they are not dirty anyway
+    if (this->bTiersDirty == false)
+    {
+        for (TelemetryTier& clTier : this->qvecTiers)
+        {
+            if (clTier.appendRow (sRecord.tTimeStamp, this->qvecColumns, this->qvecTimeStamps.size () - 1) == false)
+            {
+                this->bTiersDirty = true;
+                break;
+            }
+        }
+    }
+}
+
+
+void TelemetrySeries::rebuildTiers (void) const
+{
+    // declaration of variables
+    QVector<int> qvecRows (this->qvecTimeStamps.size ());
+    int          iCounter;
+
+    for (iCounter = 0; iCounter < qvecRows.size (); iCounter++)
+    {
+        qvecRows [iCounter] = iCounter;
+    }
+
+    if (this->bTimeOrdered == false)
+    {
+        std::stable_sort (qvecRows.begin (), qvecRows.end (), [this] (const int iA, const int iB)
+        {
+            return (this->qvecTimeStamps [iA] < this->qvecTimeStamps [iB]);
+        });
+    }
+
+    for (TelemetryTier& clTier : this->qvecTiers)
+    {
+        clTier.reset (this->qvecColumns.size ());
+        for (iCounter = 0; iCounter < qvecRows.size (); iCounter++)
+        {
+            clTier.appendRow (this->qvecTimeStamps [qvecRows [iCounter]], this->qvecColumns, qvecRows [iCounter]);
+        }
+    }
+
+    this->bTiersDirty = false;
+}
+
+
+const TelemetryTier& TelemetrySeries::tier (const int iTier) const
+{
+    if (this->bTiersDirty == true)
+    {
+        this->rebuildTiers ();
+    }
+
+    return (this->qvecTiers [qBound (0, iTier, TelemetrySeries::iNumTiers - 1)]);
+}
+
+
+int TelemetrySeries::selectTier (const qint64 tStart, const qint64 tStop, const int iMaxPoints) const
+{
+    // declaration of variables
+    int iCounter;
+    int iNumPoints;
+
+    // number of raw rows inside the range, all rows if they are not in time order
+    iNumPoints = this->qvecTimeStamps.size ();
+    if (this->bTimeOrdered == true)
+    {
+        iNumPoints = std::upper_bound (this->qvecTimeStamps.constBegin (), this->qvecTimeStamps.constEnd (), tStop) -
+                     std::lower_bound (this->qvecTimeStamps.constBegin (), this->qvecTimeStamps.constEnd (), tStart);
+    }
+
+    if (iNumPoints <= iMaxPoints)
+    {
+        return (-1);
+    }
+
+    for (iCounter = 0; iCounter < TelemetrySeries::iNumTiers; iCounter++)
+    {
+        const QVector<qint64>& qvecBuckets = this->tier (iCounter).timeStamps ();
+
+        iNumPoints = std::upper_bound (qvecBuckets.constBegin (), qvecBuckets.constEnd (), tStop) -
+                     std::lower_bound (qvecBuckets.constBegin (), qvecBuckets.constEnd (), tStart - TelemetrySeries::alliTierSeconds [iCounter]);
+        if (iNumPoints <= iMaxPoints)
+        {
+            return (iCounter);
+        }
+    }
+
+    return (TelemetrySeries::iNumTiers - 1);
+}
+
+
+QuantileSketch TelemetrySeries::sketch (const QString& qstrChannel, const qint64 tStart, const qint64 tStop) const
+{
+    // declaration of variables
+    QuantileSketch clSketch;
+    int            iIndex = this->channelIndex (qstrChannel);
+    qint64         tFirstDay;
+
+    if (iIndex < 0)
+    {
+        return (clSketch);
+    }
+
+    tFirstDay = tStart / TelemetrySeries::lliSketchSeconds;
+    if ((tStart % TelemetrySeries::lliSketchSeconds) < 0)
+    {
+        tFirstDay--;
+    }
+    tFirstDay *= TelemetrySeries::lliSketchSeconds;
+
+    for (QMap<qint64, QVector<QuantileSketch> >::const_iterator itDay = this->qmapDaySketches.lowerBound (tFirstDay);
+         (itDay != this->qmapDaySketches.constEnd ()) && (itDay.key () <= tStop); ++itDay)
+    {
+        if (iIndex < itDay.value ().size ())
+        {
+            clSketch.merge (itDay.value () [iIndex]);
+        }
+    }
+
+    return (clSketch);
+}
+
+
+void TelemetrySeries::clear (void)
+{
+    this->qvecTimeStamps.clear ();
+    this->qvecChannelNames.clear ();
+    this->qvecColumns.clear ();
+    this->qhashChannelIndex.clear ();
+    this->qvecLastChannels.clear ();
+    this->qvecLastMapping.clear ();
+    this->qmapDaySketches.clear ();
+    this->bTiersDirty   = false;
+    this->bTimeOrdered  = true;
+    this->tMinTimeStamp = 0;
+    this->tMaxTimeStamp = 0;
+    this->uiContentId   = nextContentId ();
+
+    for (TelemetryTier& clTier : this->qvecTiers)
+    {
+        clTier.reset ();
+    }
+}
+
+
+const TelemetrySeries& TelemetryStore::series (const QString& qstrComponent) const
+{
+    // declaration of variables
+    static const TelemetrySeries clEmpty;
+    QMap<QString, TelemetrySeries>::const_iterator itSeries = this->qmapSeries.constFind (qstrComponent);
+
+    if (itSeries == this->qmapSeries.constEnd ())
+    {
+        return (clEmpty);
+    }
+
+    return (itSeries.value ());
+}
+
+
+QStringList TelemetryStore::components (void) const
+{
+    return (this->qmapSeries.keys ());
+}
+
+
+bool TelemetryStore::timeRange (qint64& tFirst, qint64& tLast) const
+{
+    // declaration of variables
+    bool bRetValue = false;
+    QMap<QString, TelemetrySeries>::const_iterator itSeries;
+
+    tFirst = 0;
+    tLast  = 0;
+
+    for (itSeries = this->qmapSeries.constBegin (); itSeries != this->qmapSeries.constEnd (); ++itSeries)
+    {
+        qint64 tSeriesFirst;
+        qint64 tSeriesLast;
+
+        if (itSeries.value ().timeRange (tSeriesFirst, tSeriesLast) == true)
+        {
+            tFirst    = (bRetValue == true) ? qMin (tFirst, tSeriesFirst) : tSeriesFirst;
+            tLast     = (bRetValue == true) ? qMax (tLast,  tSeriesLast)  : tSeriesLast;
+            bRetValue = true;
+        }
+    }
+
+    return (bRetValue);
+}
+
+
+void TelemetryStore::appendRecord (const sLogRecord_t& sRecord)
+{
+    // declaration of variables
+    QMap<QString, TelemetrySeries>::iterator itSeries = this->qmapSeries.find (sRecord.qstrComponent);
+
+    if (itSeries == this->qmapSeries.end ())
+    {
+        itSeries = this->qmapSeries.insert (sRecord.qstrComponent, TelemetrySeries (sRecord.qstrComponent));
+    }
+
+    itSeries.value ().appendRecord (sRecord);
+}
+
+
+void TelemetryStore::clear (void)
+{
+    this->qmapSeries.clear ();
+}
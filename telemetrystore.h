@@ -0,0 +1,540 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file telemetrystore.h
+ *
+ * \brief contains the defintion of the TelemetrySeries and TelemetryStore classes.
+ *
+ * ---
+ */
+
+
+#ifndef TELEMETRYSTORE_H
+#define TELEMETRYSTORE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+
+#include "quantilesketch.h"
+
+
+/**
+ * decoded log message, as delivered by the component decoders.
+ */
+typedef struct
+{
+    QString          qstrComponent;     ///< log component, e.g. "HW_STATUS"
+    qint64           tTimeStamp;        ///< timestamp in epoch seconds
+    QVector<QString> qvecChannels;      ///< channel names, implicitly shared by the decoder
+    QVector<double>  qvecValues;        ///< channel values, same order as channel names
+} sLogRecord_t;
+
+
+/**
+ * \class TelemetryTier
+ *
+ * \brief This class contains a downsampled version of a TelemetrySeries.
+ *
+ * The rows of the series are aggregated into buckets of fixed length (e.g. one
+ * minute). For every channel min, mean and max of the valid (non NaN) values
+ * of a bucket are stored. The buckets are updated incrementally, when a new row
+ * is appended. Buckets without valid values are NaN.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class TelemetryTier
+{
+    private:
+        /**
+         * length of a bucket in seconds.
+         */
+        qint64 lliBucketSeconds;
+
+        /**
+         * start of the buckets in epoch seconds.
+         */
+        QVector<qint64> qvecTimeStamps;
+
+        /**
+         * min / mean / max columns, one per channel of the series.
+         */
+        QVector<QVector<double> > qvecMin;
+        QVector<QVector<double> > qvecMean;
+        QVector<QVector<double> > qvecMax;
+
+        /**
+         * sum and number of valid values of the last bucket, one per channel.
+         */
+        QVector<double> qvecSum;
+        QVector<int>    qvecCount;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const qint64 lliBucketSecondsValue = length of a bucket in seconds
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        TelemetryTier (const qint64 lliBucketSecondsValue = 60);
+
+        /**
+         * \brief Returns the length of a bucket in seconds.
+         *
+         * \return qint64 = bucket length
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        qint64 bucketSeconds (void) const;
+
+        /**
+         * \brief Returns the number of buckets.
+         *
+         * \return int = number of buckets
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        int size (void) const;
+
+        /**
+         * \brief Returns the bucket start timestamps.
+         *
+         * \return const QVector<qint64>& = start of the buckets in epoch seconds
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const QVector<qint64>& timeStamps (void) const;
+
+        /**
+         * \brief Returns the min / mean / max column of a channel.
+         *
+         * @param[in] const int iChannel = column index of the channel inside the series
+         * \return const QVector<double>& = column / empty vector if there is no such channel
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const QVector<double>& minimum (const int iChannel) const;
+        const QVector<double>& mean    (const int iChannel) const;
+        const QVector<double>& maximum (const int iChannel) const;
+
+        /**
+         * \brief Adds a new channel, filled with NaN for all existing buckets.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void addChannel (void);
+
+        /**
+         * \brief Aggregates a row of the series into the buckets.
+         *
+         * The row is added to the last bucket or starts a new one. Rows older than
+         * the last bucket can not be added incrementally.
+         *
+         * @param[in] const qint64 tTimeStamp = timestamp of the row
+         * @param[in] const QVector<QVector<double> >& qvecColumns = columns of the series
+         * @param[in] const int iRow = row index
+         * \return bool = true: OK / false: row is older than the last bucket, tier needs to be rebuilt
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool appendRow (const qint64 tTimeStamp, const QVector<QVector<double> >& qvecColumns, const int iRow);
+
+        /**
+         * \brief Removes all buckets and sets the number of channels.
+         *
+         * @param[in] const int iNumChannels = number of channels
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void reset (const int iNumChannels = 0);
+};
+
+
+/**
+ * \class TelemetrySeries
+ *
+ * \brief This class contains the decoded messages of one log component as columns.
+ *
+ * Every channel (field) of the component is stored in its own column, all columns
+ * share the timestamp column. Channels that are missing inside a message are
+ * stored as NaN.
+ * For long range views the series keeps downsampled tiers (min / mean / max per
+ * minute, hour and day), that are built incrementally while appending.
+ * For percentiles every channel has a quantile sketch per day. Sketches can be
+ * merged, hence a percentile over any range of days is answered without sorting
+ * the columns.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class TelemetrySeries
+{
+    private:
+        /**
+         * name of the log component.
+         */
+        QString qstrComponent;
+
+        /**
+         * timestamp column (epoch seconds).
+         */
+        QVector<qint64> qvecTimeStamps;
+
+        /**
+         * channel names and channel columns.
+         */
+        QVector<QString>         qvecChannelNames;
+        QVector<QVector<double> > qvecColumns;
+        QHash<QString, int>      qhashChannelIndex;
+
+        /**
+         * column mapping of the channel list of the last appended record. Decoders share
+         * their channel list between records, hence the mapping is only rebuilt if the
+         * list changes.
+         */
+        QVector<QString> qvecLastChannels;
+        QVector<int>     qvecLastMapping;
+
+        /**
+         * downsampled tiers (minute, hour, day). They are updated at append, rows that
+         * are appended out of order mark them dirty and they are rebuilt on next access.
+         */
+        mutable QVector<TelemetryTier> qvecTiers;
+        mutable bool                   bTiersDirty;
+
+        /**
+         * quantile sketches per day, key is the start of the day (epoch seconds), index
+         * is the column index. The sketches do not depend on the order of the rows.
+         */
+        QMap<qint64, QVector<QuantileSketch> > qmapDaySketches;
+
+        /**
+         * true, as long as the rows have been appended in time order.
+         */
+        bool bTimeOrdered;
+
+        /**
+         * min. and max. timestamp of the rows, updated at append.
+         */
+        qint64 tMinTimeStamp;
+        qint64 tMaxTimeStamp;
+
+        /**
+         * id of the contents, a new id is assigned whenever rows are removed. Caches of
+         * values computed from the rows (e.g. derived channels) use it to detect, that
+         * the series is not just appended any more.
+         */
+        quint64 uiContentId;
+
+        /**
+         * \brief Rebuilds all tiers from the rows.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void rebuildTiers (void) const;
+
+    public:
+        /**
+         * number of downsampled tiers and their bucket length in seconds.
+         */
+        static const int    iNumTiers = 3;
+        static const qint64 alliTierSeconds [iNumTiers];
+
+        /**
+         * bucket length of the quantile sketches in seconds.
+         */
+        static constexpr qint64 lliSketchSeconds = 86400;
+
+        /**
+         * \brief This is the class constructor.
+         *
+         * ---
+         *
+         * @param[in] const QString& qstrComponentRef = name of the log component
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        TelemetrySeries (const QString& qstrComponentRef = QString ());
+
+        /**
+         * \brief Returns the name of the log component.
+         *
+         * \return const QString& = component name
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const QString& component (void) const;
+
+        /**
+         * \brief Returns the number of rows (messages).
+         *
+         * \return int = number of rows
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        int size (void) const;
+
+        /**
+         * \brief Returns the names of all channels.
+         *
+         * \return const QVector<QString>& = channel names, index is the column index
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const QVector<QString>& channelNames (void) const;
+
+        /**
+         * \brief Returns the column index of a channel.
+         *
+         * @param[in] const QString& qstrChannel = channel name
+         * \return int = column index / -1 if there is no such channel
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        int channelIndex (const QString& qstrChannel) const;
+
+        /**
+         * \brief Adds a new channel.
+         *
+         * The column is filled with NaN for all existing rows. If the channel already
+         * exists, its index is returned.
+         *
+         * @param[in] const QString& qstrChannel = channel name
+         * \return int = column index
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        int addChannel (const QString& qstrChannel);
+
+        /**
+         * \brief Returns the timestamp column.
+         *
+         * \return const QVector<qint64>& = timestamps in epoch seconds
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const QVector<qint64>& timeStamps (void) const;
+
+        /**
+         * \brief Returns the time span of the rows.
+         *
+         * The bounds are kept at append, hence the column is not scanned.
+         *
+         * @param[out] qint64& tFirst = min. timestamp
+         * @param[out] qint64& tLast = max. timestamp
+         * \return bool = true: OK / false: the series is empty
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool timeRange (qint64& tFirst, qint64& tLast) const;
+
+        /**
+         * \brief Returns the id of the contents.
+         *
+         * The id stays the same, as long as rows are only appended.
+         *
+         * \return quint64 = content id
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        quint64 contentId (void) const;
+
+        /**
+         * \brief Returns a channel column.
+         *
+         * @param[in] const QString& qstrChannel = channel name
+         * \return const QVector<double>& = channel values / empty vector if there is no such channel
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const QVector<double>& column (const QString& qstrChannel) const;
+
+        /**
+         * \brief Appends a decoded message as new row.
+         *
+         * Channels that are not known yet are added automatically.
+         *
+         * @param[in] const sLogRecord_t& sRecord = decoded message
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void appendRecord (const sLogRecord_t& sRecord);
+
+        /**
+         * \brief Returns a downsampled tier.
+         *
+         * @param[in] const int iTier = tier index (0 = minute, 1 = hour, 2 = day)
+         * \return const TelemetryTier& = tier
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const TelemetryTier& tier (const int iTier) const;
+
+        /**
+         * \brief Selects the finest resolution, that does not exceed a number of points.
+         *
+         * Used by the plots to bind to raw data or one of the tiers, depending on the
+         * visible time range and the number of pixels.
+         *
+         * @param[in] const qint64 tStart = start of the visible range in epoch seconds
+         * @param[in] const qint64 tStop = stop of the visible range in epoch seconds
+         * @param[in] const int iMaxPoints = max. number of points inside the visible range
+         * \return int = -1: raw data / 0 ... iNumTiers - 1: tier index
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        int selectTier (const qint64 tStart, const qint64 tStop, const int iMaxPoints) const;
+
+        /**
+         * \brief Returns the quantile sketch of a channel for a time range.
+         *
+         * The day sketches of all days, that overlap the range are merged, hence the
+         * range is extended to full days.
+         *
+         * @param[in] const QString& qstrChannel = channel name
+         * @param[in] const qint64 tStart = start of the range in epoch seconds
+         * @param[in] const qint64 tStop = stop of the range in epoch seconds
+         * \return QuantileSketch = merged sketch / empty sketch if there is no such channel
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QuantileSketch sketch (const QString& qstrChannel, const qint64 tStart, const qint64 tStop) const;
+
+        /**
+         * \brief Removes all rows and channels.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void clear (void);
+};
+
+
+/**
+ * \class TelemetryStore
+ *
+ * \brief This class contains the telemetry of one station, one series per log component.
+ *
+ * ---
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class TelemetryStore
+{
+    private:
+        /**
+         * series of all components, key is the component name.
+         */
+        QMap<QString, TelemetrySeries> qmapSeries;
+
+    public:
+        /**
+         * \brief Returns the series of a component.
+         *
+         * @param[in] const QString& qstrComponent = component name
+         * \return const TelemetrySeries& = series / empty series if no message of that component was stored
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        const TelemetrySeries& series (const QString& qstrComponent) const;
+
+        /**
+         * \brief Returns the names of all components inside the store.
+         *
+         * \return QStringList = component names
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QStringList components (void) const;
+
+        /**
+         * \brief Returns the time range of all series.
+         *
+         * @param[out] qint64& tFirst = earliest timestamp of all series
+         * @param[out] qint64& tLast = latest timestamp of all series
+         * \return bool = true: OK / false: store is empty, both timestamps are 0
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool timeRange (qint64& tFirst, qint64& tLast) const;
+
+        /**
+         * \brief Appends a decoded message to the series of its component.
+         *
+         * @param[in] const sLogRecord_t& sRecord = decoded message
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void appendRecord (const sLogRecord_t& sRecord);
+
+        /**
+         * \brief Removes all series.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void clear (void);
+};
+
+#endif // TELEMETRYSTORE_H
@@ -0,0 +1,183 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file timestampdecoder.cpp
+ *
+ * \brief contains the implementation of the TimestampDecoder class.
+ *
+ * ---
+ */
+
+
+#include "timestampdecoder.h"
+#include "phasetimer.h"
+
+#include <QDate>
+#include <QDateTime>
+#include <QTime>
+
+
+/**
+ * \brief converts a fixed number of decimal digits into an int value.
+ *
+ * returns false, if any of the characters is not a digit.
+ */
+static inline bool parseDigits (const QStringView qsvField, const int iStart, const int iCount, int& iValue)
+{
+    // declaration of variables
+    int    iCounter;
+    ushort usDigit;
+
+    iValue = 0;
+    for (iCounter = iStart; iCounter < (iStart + iCount); iCounter++)
+    {
+        usDigit = qsvField [iCounter].unicode() - '0';
+        if (usDigit > 9)
+        {
+            return (false);
+        }
+        iValue = (iValue * 10) + usDigit;
+    }
+
+    return (true);
+}
+
+
+TimestampDecoder::TimestampDecoder (void)
+{
+    this->iCachedDay        = -1;
+    this->tCachedMidnight   = 0;
+    this->bCachedDayRegular = false;
+}
+
+
+bool TimestampDecoder::parseDate (const QStringView qsvDate, int& iYear, int& iMonth, int& iDay)
+{
+    // declaration of variables
+    bool bRetValue = true;
+
+    if ((qsvDate.size () != 10) ||
+        (qsvDate [4]     != QLatin1Char ('-')) ||
+        (qsvDate [7]     != QLatin1Char ('-')))
+    {
+        bRetValue = false;
+    }
+    else
+    {
+        bRetValue = parseDigits (qsvDate, 0, 4, iYear)  &&
+                    parseDigits (qsvDate, 5, 2, iMonth) &&
+                    parseDigits (qsvDate, 8, 2, iDay);
+    }
+
+    return (bRetValue);
+}
+
+
+bool TimestampDecoder::parseTime (const QStringView qsvTime, int& iHour, int& iMinute, int& iSecond)
+{
+    // declaration of variables
+    bool bRetValue = true;
+
+    if ((qsvTime.size () != 8) ||
+        (qsvTime [2]     != QLatin1Char (':')) ||
+        (qsvTime [5]     != QLatin1Char (':')))
+    {
+        bRetValue = false;
+    }
+    else
+    {
+        bRetValue = parseDigits (qsvTime, 0, 2, iHour)   &&
+                    parseDigits (qsvTime, 3, 2, iMinute) &&
+                    parseDigits (qsvTime, 6, 2, iSecond);
+
+        if ((iHour > 23) || (iMinute > 59) || (iSecond > 59))
+        {
+            bRetValue = false;
+        }
+    }
+
+    return (bRetValue);
+}
+
+
+bool TimestampDecoder::decode (const QStringView qsvDate, const QStringView qsvTime, time_t& tTimeStamp)
+{
+    // declaration of variables
+    int iYear;
+    int iMonth;
+    int iDay;
+    int iHour;
+    int iMinute;
+    int iSecond;
+    int iDayKey;
+    PhaseTimer clTimer ("timestamp");
+
+    tTimeStamp = 0;
+
+    if ((parseDate (qsvDate, iYear, iMonth, iDay)     == false) ||
+        (parseTime (qsvTime, iHour, iMinute, iSecond) == false))
+    {
+        return (false);
+    }
+
+    // only call the Qt time zone functions, if the day changed
+    iDayKey = (iYear * 10000) + (iMonth * 100) + iDay;
+    if (iDayKey != this->iCachedDay)
+    {
+        QDate clDate (iYear, iMonth, iDay);
+        if (clDate.isValid () == false)
+        {
+            return (false);
+        }
+
+        QDateTime clMidnight     (clDate,            QTime (0, 0, 0), Qt::LocalTime);
+        QDateTime clNextMidnight (clDate.addDays (1), QTime (0, 0, 0), Qt::LocalTime);
+
+        this->iCachedDay        = iDayKey;
+        this->tCachedMidnight   = clMidnight.toSecsSinceEpoch ();
+        this->bCachedDayRegular = (clMidnight.offsetFromUtc () == clNextMidnight.offsetFromUtc ());
+    }
+
+    if (this->bCachedDayRegular == true)
+    {
+        tTimeStamp = this->tCachedMidnight + (iHour * 3600) + (iMinute * 60) + iSecond;
+    }
+    else
+    {
+        QDateTime clDateTime (QDate (iYear, iMonth, iDay), QTime (iHour, iMinute, iSecond), Qt::LocalTime);
+        if (clDateTime.isValid () == false)
+        {
+            return (false);
+        }
+        tTimeStamp = clDateTime.toSecsSinceEpoch ();
+    }
+
+    return (true);
+}
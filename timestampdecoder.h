@@ -0,0 +1,144 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file timestampdecoder.h
+ *
+ * \brief contains the defintion of the TimestampDecoder class.
+ *
+ * ---
+ */
+
+
+#ifndef TIMESTAMPDECODER_H
+#define TIMESTAMPDECODER_H
+
+#include <QString>
+#include <QStringView>
+
+#include <ctime>
+
+
+/**
+ * \class TimestampDecoder
+ *
+ * \brief Converts the date / time fields of ADU log messages into epoch seconds.
+ *
+ * The log messages store the timestamp as two separate fields "yyyy-MM-dd" and
+ * "hh:mm:ss" in local time. Instead of concatenating them and using
+ * QDateTime::fromString() for every single message, the fields are decoded
+ * directly with a fixed format parser. The epoch of midnight is cached for the
+ * last decoded day, hence the Qt time zone functions are only called once per
+ * day of log data.
+ * On days with a change of the UTC offset (DST switch) the cache is not used
+ * and the timestamp is computed by QDateTime to keep the exact same results.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class TimestampDecoder
+{
+    private:
+        /**
+         * cached day as yyyymmdd value, -1 if cache is empty.
+         */
+        int iCachedDay;
+
+        /**
+         * epoch seconds of midnight of the cached day.
+         */
+        time_t tCachedMidnight;
+
+        /**
+         * true, if the UTC offset does not change during the cached day.
+         */
+        bool bCachedDayRegular;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * Initialises an empty day cache.
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        TimestampDecoder (void);
+
+        /**
+         * \brief Converts date and time field into epoch seconds.
+         *
+         * Both fields need to match the format "yyyy-MM-dd" and "hh:mm:ss" exactly,
+         * same as QDateTime::fromString() with the format "yyyy-MM-dd hh:mm:ss".
+         * The fields are interpreted as local time.
+         *
+         * @param[in] const QStringView qsvDate = date field ("yyyy-MM-dd")
+         * @param[in] const QStringView qsvTime = time field ("hh:mm:ss")
+         * @param[out] time_t& tTimeStamp = epoch seconds, 0 on error
+         * \return bool = true: OK / false: malformed date or time field
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool decode (const QStringView qsvDate, const QStringView qsvTime, time_t& tTimeStamp);
+
+        /**
+         * \brief Parses a date field with format "yyyy-MM-dd".
+         *
+         * ---
+         *
+         * @param[in] const QStringView qsvDate = date field
+         * @param[out] int& iYear = year
+         * @param[out] int& iMonth = month (1 .. 12)
+         * @param[out] int& iDay = day (1 .. 31)
+         * \return bool = true: OK / false: malformed date field
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool parseDate (const QStringView qsvDate, int& iYear, int& iMonth, int& iDay);
+
+        /**
+         * \brief Parses a time field with format "hh:mm:ss".
+         *
+         * ---
+         *
+         * @param[in] const QStringView qsvTime = time field
+         * @param[out] int& iHour = hours (0 .. 23)
+         * @param[out] int& iMinute = minutes (0 .. 59)
+         * @param[out] int& iSecond = seconds (0 .. 59)
+         * \return bool = true: OK / false: malformed time field
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static bool parseTime (const QStringView qsvTime, int& iHour, int& iMinute, int& iSecond);
+};
+
+#endif // TIMESTAMPDECODER_H
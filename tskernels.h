@@ -0,0 +1,289 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file tskernels.h
+ *
+ * \brief contains the defintion of the TSKernels class.
+ *
+ * ---
+ */
+
+
+#ifndef TSKERNELS_H
+#define TSKERNELS_H
+
+#include <cstddef>
+#include <climits>
+#include <algorithm>
+
+
+/**
+ * partial result of the 5 points median statistics. Partial results of
+ * consecutive blocks can be merged with TSKernels::mergeStats().
+ */
+typedef struct
+{
+    int                     iMin;       ///< minimum of the median filtered samples
+    int                     iMax;       ///< maximum of the median filtered samples
+    long long int           lliSum;     ///< sum of the median filtered samples
+    unsigned long long int  ullCount;   ///< number of median filtered samples
+} sTSStats_t;
+
+
+/**
+ * \class TSKernels
+ *
+ * \brief This class contains the processing kernels for time series buffers.
+ *
+ * The kernels work on plain buffers (pointer and size), hence they can be used
+ * on complete std::vector buffers as well as on blocks of a larger recording.
+ * All loops are written branch free, so that the compiler is able to vectorise
+ * them on x86 (SSE / AVX) as well as on the ARM boards (NEON).
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class TSKernels
+{
+    public:
+
+        /**
+         * window size of the median filter.
+         */
+        static const unsigned int uiMedianSize = 5;
+
+        /**
+         * \brief Computes the median of 5 values.
+         *
+         * Uses a sorting network of 7 compare / exchange steps, build from min / max
+         * operations. Same result as sorting the 5 values and picking the center one.
+         *
+         * \return int = median of the 5 values
+         *
+         * \date 2026-10-19
+         * \author MWI
+         */
+        static inline int median5 (int iA, int iB, int iC, int iD, int iE)
+        {
+            // declaration of variables
+            int iTemp;
+
+            iTemp = std::min (iA, iB); iB = std::max (iA, iB); iA = iTemp;
+            iTemp = std::min (iD, iE); iE = std::max (iD, iE); iD = iTemp;
+            iD    = std::max (iA, iD);
+            iB    = std::min (iB, iE);
+            iTemp = std::min (iB, iC); iC = std::max (iB, iC); iB = iTemp;
+            iC    = std::min (iC, iD);
+            iC    = std::max (iB, iC);
+
+            return (iC);
+        }
+
+        /**
+         * \brief Returns an empty partial result.
+         *
+         * \return sTSStats_t = empty statistics
+         *
+         * \date 2026-10-19
+         * \author MWI
+         */
+        static inline sTSStats_t emptyStats (void)
+        {
+            sTSStats_t sStats;
+
+            sStats.iMin     = INT_MAX;
+            sStats.iMax     = INT_MIN;
+            sStats.lliSum   = 0;
+            sStats.ullCount = 0;
+
+            return (sStats);
+        }
+
+        /**
+         * \brief Merges two partial results.
+         *
+         * @param[in,out] sTSStats_t& sStats = partial result, the other one is merged into
+         * @param[in] const sTSStats_t& sOther = partial result to be merged
+         *
+         * \date 2026-10-19
+         * \author MWI
+         */
+        static inline void mergeStats (sTSStats_t& sStats, const sTSStats_t& sOther)
+        {
+            sStats.iMin      = std::min (sStats.iMin, sOther.iMin);
+            sStats.iMax      = std::max (sStats.iMax, sOther.iMax);
+            sStats.lliSum   += sOther.lliSum;
+            sStats.ullCount += sOther.ullCount;
+        }
+
+        /**
+         * \brief Computes the median filtered statistics for a number of windows.
+         *
+         * Window n covers the samples piTSData [n] ... piTSData [n + 4], hence the
+         * buffer needs to contain uiNumWindows + 4 samples. Min, max and sum of the
+         * median values are computed in the same pass.
+         *
+         * @param[in] const int* piTSData = TS data buffer
+         * @param[in] const size_t uiNumWindows = number of median windows
+         * @param[in,out] sTSStats_t& sStats = statistics, the result is merged into
+         *
+         * \date 2026-10-19
+         * \author MWI
+         */
+        static void medianStats (const int* piTSData, const size_t uiNumWindows, sTSStats_t& sStats)
+        {
+            // declaration of variables
+            size_t        uiCounter;
+            int           iMin = sStats.iMin;
+            int           iMax = sStats.iMax;
+            long long int lliSum = 0;
+            int           iTemp;
+
+            for (uiCounter = 0; uiCounter < uiNumWindows; uiCounter++)
+            {
+                iTemp = median5 (piTSData [uiCounter],     piTSData [uiCounter + 1], piTSData [uiCounter + 2],
+                                 piTSData [uiCounter + 3], piTSData [uiCounter + 4]);
+
+                iMin    = std::min (iMin, iTemp);
+                iMax    = std::max (iMax, iTemp);
+                lliSum += iTemp;
+            }
+
+            sStats.iMin      = iMin;
+            sStats.iMax      = iMax;
+            sStats.lliSum   += lliSum;
+            sStats.ullCount += uiNumWindows;
+        }
+
+        /**
+         * \brief Counts the samples with an absolute value below the border values.
+         *
+         * All border values are evaluated in a single pass over the buffer. The
+         * absolute values are computed block wise into a small buffer, that stays
+         * inside the L1 cache, and are then compared against each border value.
+         * The compare / count loops are vectorised by the compiler. The absolute
+         * value is computed as unsigned value, hence INT_MIN is handled correctly.
+         *
+         * @param[in] const int* piTSData = TS data buffer
+         * @param[in] const size_t uiSize = number of samples inside buffer
+         * @param[in] const int* piBorders = border values
+         * @param[in] const size_t uiNumBorders = number of border values
+         * @param[out] unsigned long long int* pullCounts = number of samples with |x| < border, one per border value
+         *
+         * \date 2026-10-19
+         * \author MWI
+         */
+        static void countBelowBorders (const int* piTSData, const size_t uiSize,
+                                       const int* piBorders, const size_t uiNumBorders,
+                                       unsigned long long int* pullCounts)
+        {
+            // declaration of variables
+            const size_t  uiBlockSize = 2048;
+            unsigned int  auiAbs [uiBlockSize];
+            unsigned int  uiBorder;
+            unsigned int  uiCount;
+            size_t        uiStart;
+            size_t        uiLength;
+            size_t        uiCounter;
+            size_t        uiBorderCounter;
+
+            for (uiBorderCounter = 0; uiBorderCounter < uiNumBorders; uiBorderCounter++)
+            {
+                pullCounts [uiBorderCounter] = 0;
+            }
+
+            for (uiStart = 0; uiStart < uiSize; uiStart += uiBlockSize)
+            {
+                uiLength = std::min (uiBlockSize, uiSize - uiStart);
+
+                for (uiCounter = 0; uiCounter < uiLength; uiCounter++)
+                {
+                    const int iValue = piTSData [uiStart + uiCounter];
+                    auiAbs [uiCounter] = (iValue < 0) ? (0u - (unsigned int) iValue) : (unsigned int) iValue;
+                }
+
+                for (uiBorderCounter = 0; uiBorderCounter < uiNumBorders; uiBorderCounter++)
+                {
+                    // border values <= 0 cannot be undercut
+                    uiBorder = (piBorders [uiBorderCounter] > 0) ? (unsigned int) piBorders [uiBorderCounter] : 0u;
+                    uiCount  = 0;
+                    for (uiCounter = 0; uiCounter < uiLength; uiCounter++)
+                    {
+                        uiCount += (auiAbs [uiCounter] < uiBorder) ? 1u : 0u;
+                    }
+                    pullCounts [uiBorderCounter] += uiCount;
+                }
+            }
+        }
+
+        /**
+         * \brief Computes the time series parameters like min/max and DC offset.
+         *
+         * Same as Utils::getTSParameters(), but on a plain buffer. The 5 point median
+         * is computed for the windows starting at sample 0 ... size - 6.
+         *
+         * @param[in] const int* piTSData = TS data buffer
+         * @param[in] const size_t uiSize = number of samples inside buffer
+         * @param[out] int& iMin = value to store minimum amplitude value
+         * @param[out] int& iMax = value to store maximum amplitude value
+         * @param[out] int& iDCOffset = value to store DC offset value
+         * \return bool = true: OK / false: buffer too small to compute TS parameters
+         *
+         * \date 2026-10-19
+         * \author MWI
+         */
+        static bool getTSParameters (const int* piTSData, const size_t uiSize, int& iMin, int& iMax, int& iDCOffset)
+        {
+            // declaration of variables
+            bool       bRetValue = true;
+            sTSStats_t sStats    = emptyStats ();
+
+            iMin      = INT_MAX;
+            iMax      = INT_MIN;
+            iDCOffset = 0;
+
+            if (uiSize <= uiMedianSize)
+            {
+                bRetValue = false;
+            }
+            else
+            {
+                medianStats (piTSData, uiSize - uiMedianSize, sStats);
+
+                iMin      = sStats.iMin;
+                iMax      = sStats.iMax;
+                iDCOffset = (int) (sStats.lliSum / (long long int) sStats.ullCount);
+            }
+
+            return (bRetValue);
+        }
+};
+
+#endif // TSKERNELS_H
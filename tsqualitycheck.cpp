@@ -0,0 +1,223 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file tsqualitycheck.cpp
+ *
+ * \brief contains the implementation of the TSQualityCheck class.
+ *
+ * ---
+ */
+
+
+#include "tsqualitycheck.h"
+
+#include <QFile>
+#include <QFuture>
+#include <QList>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+
+/**
+ * partial QC result of one block.
+ */
+typedef struct
+{
+    sTSStats_t                          sStats;     ///< median statistics of the block
+    std::vector<unsigned long long int> vecCounts;  ///< number of samples below border values
+} sTSQCBlockResult_t;
+
+
+/**
+ * \brief computes the partial QC result of one block.
+ *
+ * the buffer contains the samples of the block, followed by up to 4 samples of the
+ * next block, which are only used for the median windows at the block seam.
+ */
+static sTSQCBlockResult_t checkBlock (const std::shared_ptr<const std::vector<int> > pclData, const size_t uiNumSamples,
+                                      const size_t uiNumWindows, const QVector<int> qvecBorders)
+{
+    // declaration of variables
+    sTSQCBlockResult_t sResult;
+
+    sResult.sStats = TSKernels::emptyStats ();
+    sResult.vecCounts.resize (qvecBorders.size ());
+
+    TSKernels::medianStats       (pclData->data (), uiNumWindows, sResult.sStats);
+    TSKernels::countBelowBorders (pclData->data (), uiNumSamples, qvecBorders.constData (),
+                                  qvecBorders.size (), sResult.vecCounts.data ());
+
+    return (sResult);
+}
+
+
+/**
+ * \brief merges a partial QC result of one block into the total result.
+ */
+static void mergeBlock (const sTSQCBlockResult_t& sBlock, sTSStats_t& sStats, std::vector<unsigned long long int>& vecCounts)
+{
+    // declaration of variables
+    size_t uiCounter;
+
+    TSKernels::mergeStats (sStats, sBlock.sStats);
+    for (uiCounter = 0; uiCounter < vecCounts.size (); uiCounter++)
+    {
+        vecCounts [uiCounter] += sBlock.vecCounts [uiCounter];
+    }
+}
+
+
+TSQualityCheck::TSQualityCheck (void)
+{
+    this->lliBlockSize       = 1024 * 1024;
+    this->iMaxBlocksInFlight = 0;
+}
+
+
+void TSQualityCheck::setBlockSize (const qint64 lliBlockSizeValue)
+{
+    this->lliBlockSize = qMax (lliBlockSizeValue, (qint64) 1024);
+}
+
+
+void TSQualityCheck::setMaxBlocksInFlight (const int iMaxBlocksInFlightValue)
+{
+    this->iMaxBlocksInFlight = qMax (iMaxBlocksInFlightValue, 0);
+}
+
+
+bool TSQualityCheck::checkFile (const QString& qstrFileName, const qint64 lliDataOffset,
+                                const QVector<int>& qvecBorders, sTSQCResult_t& sResult) const
+{
+    // declaration of variables
+    bool                                bRetValue = true;
+    QFile                               qfRecording;
+    qint64                              lliNumSamples;
+    qint64                              lliStart;
+    qint64                              lliEnd;
+    qint64                              lliLookAhead;
+    qint64                              lliNumWindows;
+    qint64                              lliBytes;
+    int                                 iMaxBlocksInFlight;
+    QList<QFuture<sTSQCBlockResult_t> > qlistPending;
+    sTSStats_t                          sStats = TSKernels::emptyStats ();
+    std::vector<unsigned long long int> vecCounts (qvecBorders.size (), 0);
+    int                                 iCounter;
+
+    sResult.ullNumSamples = 0;
+    sResult.iMin          = INT_MAX;
+    sResult.iMax          = INT_MIN;
+    sResult.iDCOffset     = 0;
+    sResult.qvecBorders   = qvecBorders;
+    sResult.qvecBelowFraction.fill (0.0, qvecBorders.size ());
+
+    qfRecording.setFileName (qstrFileName);
+    if (qfRecording.open (QIODevice::ReadOnly) == false)
+    {
+        #ifdef C_TS_QUALITY_CHECK_DEBUG_MSG
+            printf ("[%s] failed to open recording: %s\n", C_TS_QUALITY_CHECK_NAME, qstrFileName.toStdString ().c_str ());
+            fflush (stdout);
+        #endif
+        return (false);
+    }
+
+    lliNumSamples = (qfRecording.size () - lliDataOffset) / (qint64) sizeof (int);
+    if ((lliDataOffset < 0) || (lliNumSamples <= (qint64) TSKernels::uiMedianSize))
+    {
+        return (false);
+    }
+
+    iMaxBlocksInFlight = this->iMaxBlocksInFlight;
+    if (iMaxBlocksInFlight == 0)
+    {
+        iMaxBlocksInFlight = 2 * qMax (QThreadPool::globalInstance ()->maxThreadCount (), 1);
+    }
+
+    // the file is read sequentially by this thread, the blocks are processed by the
+    // thread pool. every block reads 4 samples of the next block for the median windows
+    // at the block seam. the last median window starts at sample n - 6, same as for
+    // Utils::getTSParameters()
+    for (lliStart = 0; (lliStart < lliNumSamples) && (bRetValue == true); lliStart = lliEnd)
+    {
+        lliEnd        = qMin (lliStart + this->lliBlockSize, lliNumSamples);
+        lliLookAhead  = qMin ((qint64) TSKernels::uiMedianSize - 1, lliNumSamples - lliEnd);
+        lliNumWindows = qMax (qMin (lliEnd, lliNumSamples - (qint64) TSKernels::uiMedianSize) - lliStart, (qint64) 0);
+
+        std::shared_ptr<std::vector<int> > pclData = std::make_shared<std::vector<int> > (lliEnd - lliStart + lliLookAhead);
+        lliBytes = (qint64) (pclData->size () * sizeof (int));
+
+        if ((qfRecording.seek (lliDataOffset + (lliStart * (qint64) sizeof (int))) == false) ||
+            (qfRecording.read (reinterpret_cast<char*> (pclData->data ()), lliBytes) != lliBytes))
+        {
+            #ifdef C_TS_QUALITY_CHECK_DEBUG_MSG
+                printf ("[%s] failed to read block at sample %lli\n", C_TS_QUALITY_CHECK_NAME, lliStart);
+                fflush (stdout);
+            #endif
+            bRetValue = false;
+            break;
+        }
+
+        qlistPending.append (QtConcurrent::run (checkBlock, std::shared_ptr<const std::vector<int> > (pclData),
+                                                (size_t) (lliEnd - lliStart), (size_t) lliNumWindows, qvecBorders));
+
+        // limit the number of buffered blocks
+        while (qlistPending.size () >= iMaxBlocksInFlight)
+        {
+            mergeBlock (qlistPending.takeFirst ().result (), sStats, vecCounts);
+        }
+    }
+
+    // always wait for the pending blocks, they reference the buffers
+    while (qlistPending.isEmpty () == false)
+    {
+        mergeBlock (qlistPending.takeFirst ().result (), sStats, vecCounts);
+    }
+
+    qfRecording.close ();
+
+    if (bRetValue == true)
+    {
+        sResult.ullNumSamples = (unsigned long long int) lliNumSamples;
+        sResult.iMin          = sStats.iMin;
+        sResult.iMax          = sStats.iMax;
+        sResult.iDCOffset     = (int) (sStats.lliSum / (long long int) sStats.ullCount);
+
+        for (iCounter = 0; iCounter < qvecBorders.size (); iCounter++)
+        {
+            sResult.qvecBelowFraction [iCounter] = ((double) vecCounts [iCounter]) / ((double) lliNumSamples);
+        }
+    }
+
+    return (bRetValue);
+}
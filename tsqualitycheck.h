@@ -0,0 +1,145 @@
+/***************************************************************************
+**                                                                        **
+**  Log Analyzer - Metronix ADU-XX system log analyzer                    **
+**  Copyright (C) 2019-2022 metronix GmbH                                 **
+**                                                                        **
+**  This program is free software: you can redistribute it and/or modify  **
+**  it under the terms of the GNU General Public License as published by  **
+**  the Free Software Foundation, either version 3 of the License, or     **
+**  (at your option) any later version.                                   **
+**                                                                        **
+**  This program is distributed in the hope that it will be useful,       **
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of        **
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         **
+**  GNU General Public License for more details.                          **
+**                                                                        **
+**  You should have received a copy of the GNU General Public License     **
+**  along with this program.  If not, see http://www.gnu.org/licenses/.   **
+**                                                                        **
+** Parts of the software are linked against the Open Source Version of Qt **
+** Qt source code copy is available under https://www.qt.io               **
+** Qt source code modifications are non-proprietary,no modifications made **
+** https://www.qt.io/licensing/open-source-lgpl-obligations               **
+****************************************************************************
+**           Author: metronix geophysics                                  **
+**  Website/Contact: www.metronix.de                                      **
+**                                                                        **
+**                                                                        **
+****************************************************************************/
+
+/**
+ * \file tsqualitycheck.h
+ *
+ * \brief contains the defintion of the TSQualityCheck class.
+ *
+ * ---
+ */
+
+
+#ifndef TSQUALITYCHECK_H
+#define TSQUALITYCHECK_H
+
+#include <QString>
+#include <QVector>
+
+#include "tskernels.h"
+
+
+#define C_TS_QUALITY_CHECK_NAME "TSQualityCheck"
+
+
+/**
+ * result of the QC of a complete time series recording.
+ */
+typedef struct
+{
+    unsigned long long int  ullNumSamples;      ///< number of samples inside the recording
+    int                     iMin;               ///< minimum of the median filtered samples
+    int                     iMax;               ///< maximum of the median filtered samples
+    int                     iDCOffset;          ///< mean of the median filtered samples
+    QVector<int>            qvecBorders;        ///< border values, that have been checked
+    QVector<double>         qvecBelowFraction;  ///< fraction of samples with |x| < border, one per border value
+} sTSQCResult_t;
+
+
+/**
+ * \class TSQualityCheck
+ *
+ * \brief Computes the TS parameters and border checks for a complete recording on disk.
+ *
+ * The recording is read in blocks of int32 samples. The blocks are processed
+ * in parallel on the global thread pool, the partial results are merged.
+ * Every block reads the first 4 samples of the following block as well, hence the
+ * 5 points median windows at the block seams are computed exactly once and the
+ * result equals Utils::getTSParameters() / Utils::getTSBorderFractions() for the
+ * complete recording inside one buffer.
+ * The number of blocks in flight is limited, hence the memory usage is bound to
+ * a few blocks per thread, independent of the size of the recording.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class TSQualityCheck
+{
+    private:
+        /**
+         * number of samples per block.
+         */
+        qint64 lliBlockSize;
+
+        /**
+         * max. number of blocks in flight, 0 = 2 blocks per thread of the global thread pool.
+         */
+        int iMaxBlocksInFlight;
+
+    public:
+        /**
+         * \brief This is the class constructor.
+         *
+         * Default block size is 1M samples (4 MB).
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        TSQualityCheck (void);
+
+        /**
+         * \brief Sets the number of samples per block.
+         *
+         * @param[in] const qint64 lliBlockSizeValue = number of samples per block (min. 1024)
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void setBlockSize (const qint64 lliBlockSizeValue);
+
+        /**
+         * \brief Sets the max. number of blocks, that are processed / buffered at the same time.
+         *
+         * @param[in] const int iMaxBlocksInFlightValue = max. number of blocks, 0 = 2 per thread
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void setMaxBlocksInFlight (const int iMaxBlocksInFlightValue);
+
+        /**
+         * \brief Executes the QC for a recording file.
+         *
+         * The file needs to contain the samples as little endian int32 values, starting
+         * at the data offset (e.g. the header length of an ATS file).
+         *
+         * @param[in] const QString& qstrFileName = path to recording file
+         * @param[in] const qint64 lliDataOffset = offset of the first sample in bytes
+         * @param[in] const QVector<int>& qvecBorders = border values for the border check
+         * @param[out] sTSQCResult_t& sResult = QC result
+         * \return bool = true: OK / false: failed to read file or not enough samples
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool checkFile (const QString& qstrFileName, const qint64 lliDataOffset,
+                        const QVector<int>& qvecBorders, sTSQCResult_t& sResult) const;
+};
+
+#endif // TSQUALITYCHECK_H
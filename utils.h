@@ -25,6 +25,7 @@
 #include <sys/stat.h>
 
 #include "globalincludes.h"
+#include "tskernels.h"
 
 #include <QThread>
 #include <QFile>
@@ -422,6 +423,8 @@ class Timer : public QThread
          *
          * Receives the time series buffer as std::vector<int>. It will use a
          * 5 points median filter for spike reduction.
+         * The median is computed by the sorting network of TSKernels in a single
+         * pass together with min / max and DC offset.
          *
          * @param[in] const std::vector<int>& vecTSData = TS data buffer
          * @param[out] int& iMin = value to store minimum amplitude value
@@ -434,63 +437,14 @@ class Timer : public QThread
          */
         static bool getTSParameters (const std::vector<int>& vecTSData, int& iMin, int& iMax, int& iDCOffset)
         {
-            // declaration of variables
-            bool          bRetValue = true;
-            int           iTemp;
-            long long int lliOffset = 0;
-            unsigned int  uiCounter;
-            unsigned int  uiCounter2;
-            unsigned int  uiIndex;
-            std::vector<int> vecMedian;
-
-            vecMedian.resize(5);
-            uiIndex = floor (vecMedian.size() / 2.0);
-
-            iMin      = INT_MAX;
-            iMax      = INT_MIN;
-            iDCOffset = 0;
-
-            if (vecTSData.size() < vecMedian.size())
-            {
-                bRetValue = false;
-            }
-            else
-            {
-
-                for (uiCounter = 0; uiCounter < (vecTSData.size() - vecMedian.size()); uiCounter++)
-                {
-                    for (uiCounter2 = 0; uiCounter2 < vecMedian.size(); uiCounter2++)
-                    {
-                        vecMedian [uiCounter2] = vecTSData [uiCounter + uiCounter2];
-                    }
-                    std::sort(vecMedian.begin(), vecMedian.end(), std::greater<int>());
-                    iTemp = vecMedian [uiIndex];
-
-                    if (iTemp > iMax)
-                    {
-                        iMax = iTemp;
-                    }
-
-                    if (iTemp < iMin)
-                    {
-                        iMin = iTemp;
-                    }
-
-                    lliOffset += iTemp;
-                }
-
-                lliOffset /= uiCounter;
-                iDCOffset  = (int)lliOffset;
-            }
-
-            return (bRetValue);
+            return (TSKernels::getTSParameters (vecTSData.data(), vecTSData.size(), iMin, iMax, iDCOffset));
         }
 
 
         /**
          * \brief This function checks, if n percent are bigger / smaller than a border value.
          *
-         * It takes the complete TS data buffer and sorts it in ascending order.
+         * It counts the samples of the TS data buffer below the border values.
          * Afterwards it executes 2 checks:<br>
          *<br>
          *1.) n percent < border 1<br>
@@ -511,47 +465,67 @@ class Timer : public QThread
          * \date 2016-01-19
          * \author MWI
          */
-        static bool checkTSBorderValues (std::vector<int> vecTSData,
+        static bool checkTSBorderValues (const std::vector<int>& vecTSData,
+                                         const int iBorder1, const double dBorder1Percent, bool& bBorder1Exceeded,
+                                         const int iBorder2, const double dBorder2Percent, bool& bBorder2Exceeded)
+        {
+            return (checkTSBorderValues (vecTSData.data(), vecTSData.size(),
+                                         iBorder1, dBorder1Percent, bBorder1Exceeded,
+                                         iBorder2, dBorder2Percent, bBorder2Exceeded));
+        }
+
+
+        /**
+         * \brief This function checks, if n percent are bigger / smaller than a border value.
+         *
+         * Same as the function above, but works on a view of the TS data buffer
+         * (pointer and size), hence the buffer is neither copied nor modified.
+         *
+         * @param[in] const int* piTSData = TS data buffer
+         * @param[in] const size_t uiSize = number of samples inside TS data buffer
+         * @param[in] const int iBorder1 = border value 1
+         * @param[in] const double dBorder1Percent = percentage value for border 1 check
+         * @param[out] bool& bBorder1Exceeded = reference to boolean value for border 1 check
+         * @param[in] const int iBorder2 = border value 2
+         * @param[in] const double dBorder2Percent = percentage value for border 2 check
+         * @param[out] bool& bBorder2Exceeded = reference to boolean value for border 2 check
+         * \return bool = true: OK / false: empty buffer
+         *
+         * \date 2026-10-19
+         * \author MWI
+         */
+        static bool checkTSBorderValues (const int* piTSData, const size_t uiSize,
                                          const int iBorder1, const double dBorder1Percent, bool& bBorder1Exceeded,
                                          const int iBorder2, const double dBorder2Percent, bool& bBorder2Exceeded)
         {
             // declaration of variables
-            bool         bRetValue     = true;
-            int          iBorder1Index = 0;
-            int          iBorder2Index = 0;
-            double       dBorder1Index = 0;
-            double       dBorder2Index = 0;
-            unsigned int uiCounter;
+            bool                    bRetValue     = true;
+            double                  dBorder1Index = 0;
+            double                  dBorder2Index = 0;
+            int                     aiBorders [2];
+            unsigned long long int  aullCounts [2];
 
             bBorder1Exceeded = false;
             bBorder2Exceeded = false;
 
-            std::sort(vecTSData.begin(), vecTSData.end(), std::greater<int>());
+            if (uiSize == 0)
+            {
+                return (false);
+            }
 
             #ifdef C_UTILS_DEBUG_MSG
                 printf ("[%s] checking TS data buffer border values ...\n", C_UTILS_NAME);
                 fflush (stdout);
             #endif
 
-            for (uiCounter = 0; uiCounter < vecTSData.size(); uiCounter++)
-            {
-                if (abs(vecTSData [uiCounter]) < iBorder1)
-                {
-                    iBorder1Index++;
-                }
-
-                if (abs (vecTSData [uiCounter]) < iBorder2)
-                {
-                    iBorder2Index++;
-                }
-            }
+            aiBorders [0] = iBorder1;
+            aiBorders [1] = iBorder2;
+            TSKernels::countBelowBorders (piTSData, uiSize, aiBorders, 2, aullCounts);
 
             // border 2 should compute the values > border value, therefore subtract here from
-            // vector size to get the number of samples > border value
-            iBorder2Index = vecTSData.size() - iBorder2Index;
-
-            dBorder1Index = (((double)iBorder1Index) / ((double)vecTSData.size()));
-            dBorder2Index = (((double)iBorder2Index) / ((double)vecTSData.size()));
+            // buffer size to get the number of samples > border value
+            dBorder1Index = (((double) aullCounts [0])            / ((double) uiSize));
+            dBorder2Index = (((double) (uiSize - aullCounts [1])) / ((double) uiSize));
 
             if (dBorder1Index >= dBorder1Percent)
             {
@@ -573,6 +547,46 @@ class Timer : public QThread
         }
 
 
+        /**
+         * \brief Computes the fraction of samples below several border values at once.
+         *
+         * All border values are evaluated in a single pass over the TS data buffer.
+         * The fraction of samples above a border value is 1.0 - fraction below.
+         *
+         * @param[in] const int* piTSData = TS data buffer
+         * @param[in] const size_t uiSize = number of samples inside TS data buffer
+         * @param[in] const std::vector<int>& vecBorders = border values
+         * @param[out] std::vector<double>& vecBelowFraction = fraction of samples with |x| < border, one per border value
+         * \return bool = true: OK / false: empty buffer
+         *
+         * \date 2026-10-19
+         * \author MWI
+         */
+        static bool getTSBorderFractions (const int* piTSData, const size_t uiSize,
+                                          const std::vector<int>& vecBorders, std::vector<double>& vecBelowFraction)
+        {
+            // declaration of variables
+            unsigned int uiCounter;
+            std::vector<unsigned long long int> vecCounts (vecBorders.size());
+
+            vecBelowFraction.assign (vecBorders.size(), 0.0);
+
+            if (uiSize == 0)
+            {
+                return (false);
+            }
+
+            TSKernels::countBelowBorders (piTSData, uiSize, vecBorders.data(), vecBorders.size(), vecCounts.data());
+
+            for (uiCounter = 0; uiCounter < vecCounts.size(); uiCounter++)
+            {
+                vecBelowFraction [uiCounter] = ((double) vecCounts [uiCounter]) / ((double) uiSize);
+            }
+
+            return (true);
+        }
+
+
         /**
          * \brief Tries to read the Type ID and serial number from the NAND flash file.
          *
@@ -37,6 +37,41 @@
 
 
 #include "xmlparses.h"
+#include "numberparser.h"
+#include "phasetimer.h"
+
+
+
+XMLPath::XMLPath (void)
+{
+}
+
+
+XMLPath::XMLPath (const QVector<QString>& qvecXmlPath)
+{
+    // declaration of variables
+    int     iCounter;
+    QString qstrKey;
+
+    this->qvecElements = qvecXmlPath;
+    this->qvecPrefixKeys.reserve(qvecXmlPath.size());
+    for (iCounter = 0; iCounter < qvecXmlPath.size(); iCounter++)
+    {
+        if (iCounter > 0)
+        {
+            qstrKey += QLatin1Char ('/');
+        }
+        qstrKey += qvecXmlPath [iCounter];
+        this->qvecPrefixKeys.push_back(qstrKey);
+    }
+}
+
+
+int XMLPath::depth (void) const
+{
+    return (this->qvecElements.size());
+}
+
 
 XMLParser::XMLParser()
 {
@@ -52,7 +87,8 @@ XMLParser::~XMLParser()
 bool XMLParser::readXmlFromString (const QString qstrXmlFile)
 {
     // declaration of variables
-    bool bRetValue = true;
+    bool       bRetValue = true;
+    PhaseTimer clTimer ("xml_parse");
 
     if (qstrXmlFile.size() == 0)
     {
@@ -62,6 +98,7 @@ bool XMLParser::readXmlFromString (const QString qstrXmlFile)
     {
         try
         {
+            this->clearPathCache();
             this->clXmlDoc.clear();
             bRetValue = this->clXmlDoc.setContent(qstrXmlFile);
         }
@@ -75,70 +112,92 @@ bool XMLParser::readXmlFromString (const QString qstrXmlFile)
 }
 
 
+QDomNode XMLParser::getDocumentNode (void) const
+{
+    return (this->clXmlDoc);
+}
+
+
 bool XMLParser::findXmlNode (QVector<QString> qvecXmlPath, const unsigned int uiIndex, QDomNode& clTargetNode)
+{
+    return (this->findXmlNode (XMLPath (qvecXmlPath), uiIndex, clTargetNode));
+}
+
+
+bool XMLParser::findXmlNode (const XMLPath& clXmlPath, const unsigned int uiIndex, QDomNode& clTargetNode)
 {
     // declaration of variables
     bool          bRetValue = true;
-    unsigned int  uiPathCount;
-    unsigned int  uiIndexCount;
+    int           iDepth    = clXmlPath.depth();
+    int           iCounter;
     int           iErrCondition = 0;
     QDomNode      clTmpNode;
     QDomNodeList  clTmpNodeList;
+    QHash<QString, QHash<unsigned int, QDomNode> >::const_iterator itIndexMap;
+    QHash<unsigned int, QDomNode>::const_iterator itNode;
 
     clTargetNode.clear();
-    clTmpNode.clear();
 
-    if (qvecXmlPath.size() > 0)
+    if (iDepth <= 0)
+    {
+        bRetValue = false;
+        iErrCondition = -3;
+    }
+    else if (uiIndex == 0xFFFFFFFF)
+    {
+        clTargetNode = this->resolvePathPrefix(clXmlPath, iDepth);
+        if (clTargetNode.isNull() == true)
+        {
+            bRetValue = false;
+            iErrCondition = -2;
+        }
+    }
+    else
     {
-        for (uiPathCount = 0; uiPathCount < (unsigned int)qvecXmlPath.size(); uiPathCount++)
+        // the id -> node map of the last path element is built on first use
+        itIndexMap = this->qhashPathIndex.constFind(clXmlPath.qvecPrefixKeys.last());
+        if (itIndexMap == this->qhashPathIndex.constEnd())
         {
-            if (clTmpNode.isNull() == true)
+            QHash<unsigned int, QDomNode> qhashIdMap;
+
+            clTmpNode = this->resolvePathPrefix(clXmlPath, iDepth - 1);
+            if (iDepth == 1)
             {
-                clTmpNodeList = this->clXmlDoc.elementsByTagName(qvecXmlPath[uiPathCount]);
+                clTmpNodeList = this->clXmlDoc.elementsByTagName(clXmlPath.qvecElements.last());
             }
-            else
+            else if (clTmpNode.isNull() == false)
             {
-                clTmpNodeList = clTmpNode.toElement().elementsByTagName(qvecXmlPath[uiPathCount]);
+                clTmpNodeList = clTmpNode.toElement().elementsByTagName(clXmlPath.qvecElements.last());
             }
 
-            if (clTmpNodeList.size() > 0)
+            // last node with a matching id wins, same as the linear search
+            for (iCounter = 0; iCounter < clTmpNodeList.size(); iCounter++)
             {
-                if (((int)uiPathCount == (qvecXmlPath.size() - 1)) &&
-                    (uiIndex     != 0xFFFFFFFF))
-                {
-                    for (uiIndexCount = 0; uiIndexCount < (unsigned int)clTmpNodeList.size(); uiIndexCount++)
-                    {
-                        if (clTmpNodeList.at(uiIndexCount).attributes().namedItem("id").nodeValue().toUInt() == uiIndex)
-                        {
-                            clTargetNode = clTmpNodeList.at(uiIndexCount);
-                        }
-                    }
-
-                    if (clTargetNode.isNull() == true)
-                    {
-                        bRetValue = false;
-                        iErrCondition = -1;
-                    }
-                }
-                else
-                {
-                    clTmpNode = clTmpNodeList.at(0);
-                }
+                qhashIdMap.insert(clTmpNodeList.at(iCounter).attributes().namedItem("id").nodeValue().toUInt(),
+                                  clTmpNodeList.at(iCounter));
+            }
+            itIndexMap = this->qhashPathIndex.insert(clXmlPath.qvecPrefixKeys.last(), qhashIdMap);
+        }
 
+        if (itIndexMap.value().isEmpty() == true)
+        {
+            bRetValue = false;
+            iErrCondition = -2;
+        }
+        else
+        {
+            itNode = itIndexMap.value().constFind(uiIndex);
+            if (itNode != itIndexMap.value().constEnd())
+            {
+                clTargetNode = itNode.value();
             }
             else
             {
                 bRetValue = false;
-                iErrCondition = -2;
-                break;
+                iErrCondition = -1;
             }
         }
     }
-    else
-    {
-        bRetValue = false;
-        iErrCondition = -3;
-    }
 
     if (bRetValue == false)
     {
@@ -147,32 +206,79 @@ bool XMLParser::findXmlNode (QVector<QString> qvecXmlPath, const unsigned int ui
         #endif
     }
 
-
-
     return (bRetValue);
 }
 
 
-bool XMLParser::getSubNodeValue (const QString qstrSubNodeName, QDomNode clRootNode, QString& qstrNodeValue)
+QDomNode XMLParser::resolvePathPrefix (const XMLPath& clXmlPath, const int iDepth)
 {
     // declaration of variables
-    bool          bRetValue = true;
-    QDomNodeList  clTmpNodeList;
+    int      iLevel;
+    QDomNode clNode = this->clXmlDoc;
+    QHash<QString, QDomNode>::const_iterator itNode;
 
-    qstrNodeValue.clear();
+    // start at the deepest prefix, that has already been resolved
+    for (iLevel = iDepth; iLevel > 0; iLevel--)
+    {
+        itNode = this->qhashPathNodes.constFind(clXmlPath.qvecPrefixKeys [iLevel - 1]);
+        if (itNode != this->qhashPathNodes.constEnd())
+        {
+            clNode = itNode.value();
+            break;
+        }
+    }
 
-    if (clRootNode.isNull() == true)
+    while ((iLevel < iDepth) && (clNode.isNull() == false))
     {
-        clTmpNodeList = this->clXmlDoc.elementsByTagName(qstrSubNodeName);
+        clNode = findFirstSubNode (clXmlPath.qvecElements [iLevel], clNode);
+        this->qhashPathNodes.insert(clXmlPath.qvecPrefixKeys [iLevel], clNode);
+        iLevel++;
     }
-    else
+
+    return (clNode);
+}
+
+
+void XMLParser::clearPathCache (void)
+{
+    this->qhashPathNodes.clear();
+    this->qhashPathIndex.clear();
+}
+
+
+QDomNode XMLParser::findFirstSubNode (const QString& qstrSubNodeName, const QDomNode& clRootNode)
+{
+    // returns the first node in document order, same as elementsByTagName().at(0),
+    // but stops at the first match and does not build a node list.
+    return (XMLParser::walkSubNodes (clRootNode, [&qstrSubNodeName] (const QDomNode& clNode)
+    {
+        return (clNode.nodeName() == qstrSubNodeName);
+    }));
+}
+
+
+QDomNode XMLParser::findValueNode (const QString& qstrSubNodeName, const QDomNode& clRootNode) const
+{
+    if (clRootNode.isNull() == true)
     {
-        clTmpNodeList = clRootNode.toElement().elementsByTagName(qstrSubNodeName);
+        return (findFirstSubNode (qstrSubNodeName, this->clXmlDoc));
     }
 
-    if (clTmpNodeList.size() > 0)
+    return (findFirstSubNode (qstrSubNodeName, clRootNode));
+}
+
+
+bool XMLParser::getSubNodeValue (const QString qstrSubNodeName, QDomNode clRootNode, QString& qstrNodeValue)
+{
+    // declaration of variables
+    bool          bRetValue = true;
+    QDomNode      clTmpNode = this->findValueNode (qstrSubNodeName, clRootNode);
+
+    qstrNodeValue.clear();
+
+    if (clTmpNode.isNull() == false)
     {
-        qstrNodeValue = clTmpNodeList.at(0).firstChild().nodeValue();
+        qstrNodeValue = clTmpNode.firstChild().nodeValue();
     }
     else
     {
@@ -186,13 +292,12 @@ bool XMLParser::getSubNodeValue (const QString qstrSubNodeName, QDomNode clRootN
 bool XMLParser::getSubNodeValue (const QString qstrSubNodeName, QDomNode clRootNode, unsigned int& uiNodeValue)
 {
     // declaration of variables
-    bool    bRetValue = true;
-    QString qstrTemp;
+    bool     bRetValue = false;
+    QDomNode clTmpNode = this->findValueNode (qstrSubNodeName, clRootNode);
 
-    bRetValue = this->getSubNodeValue(qstrSubNodeName, clRootNode, qstrTemp);
-    if (bRetValue == true)
+    if (clTmpNode.isNull() == false)
     {
-        uiNodeValue = qstrTemp.toUInt(&bRetValue);
+        bRetValue = NumberParser::toUInt (clTmpNode.firstChild().nodeValue(), uiNodeValue);
     }
 
     if (bRetValue == false)
@@ -207,13 +312,12 @@ bool XMLParser::getSubNodeValue (const QString qstrSubNodeName, QDomNode clRootN
 bool XMLParser::getSubNodeValue (const QString qstrSubNodeName, QDomNode clRootNode, int& iNodeValue)
 {
     // declaration of variables
-    bool    bRetValue = true;
-    QString qstrTemp;
+    bool     bRetValue = false;
+    QDomNode clTmpNode = this->findValueNode (qstrSubNodeName, clRootNode);
 
-    bRetValue = this->getSubNodeValue(qstrSubNodeName, clRootNode, qstrTemp);
-    if (bRetValue == true)
+    if (clTmpNode.isNull() == false)
     {
-        iNodeValue = qstrTemp.toInt(&bRetValue);
+        bRetValue = NumberParser::toInt (clTmpNode.firstChild().nodeValue(), iNodeValue);
     }
 
     if (bRetValue == false)
@@ -228,14 +332,13 @@ bool XMLParser::getSubNodeValue (const QString qstrSubNodeName, QDomNode clRootN
 bool XMLParser::getSubNodeValue (const QString qstrSubNodeName, QDomNode clRootNode, bool& bNodeValue)
 {
     // declaration of variables
-    bool    bRetValue = true;
-    int     iTemp;
-    QString qstrTemp;
+    bool     bRetValue = false;
+    int      iTemp     = 0;
+    QDomNode clTmpNode = this->findValueNode (qstrSubNodeName, clRootNode);
 
-    bRetValue = this->getSubNodeValue(qstrSubNodeName, clRootNode, qstrTemp);
-    if (bRetValue == true)
+    if (clTmpNode.isNull() == false)
     {
-        iTemp = qstrTemp.toInt(&bRetValue);
+        bRetValue = NumberParser::toInt (clTmpNode.firstChild().nodeValue(), iTemp);
         switch (iTemp)
         {
             case 0:
@@ -269,13 +372,12 @@ bool XMLParser::getSubNodeValue (const QString qstrSubNodeName, QDomNode clRootN
 bool XMLParser::getSubNodeValue (const QString qstrSubNodeName, QDomNode clRootNode, double& dNodeValue)
 {
     // declaration of variables
-    bool    bRetValue = true;
-    QString qstrTemp;
+    bool     bRetValue = false;
+    QDomNode clTmpNode = this->findValueNode (qstrSubNodeName, clRootNode);
 
-    bRetValue = this->getSubNodeValue(qstrSubNodeName, clRootNode, qstrTemp);
-    if (bRetValue == true)
+    if (clTmpNode.isNull() == false)
     {
-        dNodeValue = qstrTemp.toDouble(&bRetValue);
+        bRetValue = NumberParser::toDouble (clTmpNode.firstChild().nodeValue(), dNodeValue);
     }
 
     if (bRetValue == false)
@@ -372,6 +474,7 @@ bool XMLParser::insertXmlFile (QDomNode* pclNode, const QString& qstrXmlFile)
     clDocTemp.setContent (qstrXmlFile);
 
     pclNode->parentNode ().parentNode ().insertAfter (clDocTemp.documentElement(), pclNode->parentNode ());
+    this->clearPathCache();
 
     clDocTemp.clear ();
 
@@ -40,6 +40,8 @@
 #define XMLPARSER_H
 
 #include <QString>
+#include <QVector>
+#include <QHash>
 #include <QDebug>
 #include <QDomDocument>
 
@@ -50,6 +52,71 @@
 #define C_XML_PARSER_NAME "XMLParser"
 
 
+/**
+ * \class XMLPath
+ *
+ * \brief This class contains a compiled path to be used with XMLParser::findXmlNode().
+ *
+ * The path is compiled once and can then be used for any number of lookups on
+ * any XMLParser instance. It contains the keys of all path prefixes, that are
+ * used by the XMLParser to memorise already resolved nodes. Hence repeated
+ * lookups of the same path do not scan the document again.
+ *
+ * \author MWI
+ * \date 2026-10-19
+ */
+class XMLPath
+{
+    friend class XMLParser;
+
+    private:
+        /**
+         * node names of the path elements.
+         */
+        QVector<QString> qvecElements;
+
+        /**
+         * keys of the path prefixes: element 0 .. n joined by "/".
+         */
+        QVector<QString> qvecPrefixKeys;
+
+    public:
+        /**
+         * \brief Constructs an empty path.
+         *
+         * ---
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        XMLPath (void);
+
+        /**
+         * \brief Compiles the path from a vector of node names.
+         *
+         * ---
+         *
+         * @param[in] const QVector<QString>& qvecXmlPath = vector of strings defining the path inside the XML file
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        XMLPath (const QVector<QString>& qvecXmlPath);
+
+        /**
+         * \brief Returns the number of path elements.
+         *
+         * ---
+         *
+         * \return int = number of path elements
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        int depth (void) const;
+};
+
+
 /**
  * \class XMLParser
  *
@@ -73,6 +140,59 @@ class XMLParser
          */
         QDomDocument clXmlDoc;
 
+        /**
+         * \brief Searches the first subnode with a given name below the root node.
+         *
+         * Walks the subtree in document order and stops at the first match. Same
+         * result as elementsByTagName().at(0), but without building a node list.
+         *
+         * @param[in] const QString& qstrSubNodeName = name of the subnode to be searched for
+         * @param[in] const QDomNode& clRootNode = root node, the search shall be started on
+         * \return QDomNode = first matching subnode / NULL node if not found
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        static QDomNode findFirstSubNode (const QString& qstrSubNodeName, const QDomNode& clRootNode);
+
+        /**
+         * \brief Searches the subnode, that is read by the getSubNodeValue () functions.
+         *
+         * @param[in] const QString& qstrSubNodeName = name of the subnode to be searched for
+         * @param[in] const QDomNode& clRootNode = root node, the search shall be started on / NULL node: document
+         * \return QDomNode = first matching subnode / NULL node if not found
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QDomNode findValueNode (const QString& qstrSubNodeName, const QDomNode& clRootNode) const;
+
+        /**
+         * memorised nodes of already resolved path prefixes, key is the prefix key of
+         * the XMLPath. NULL nodes are stored for paths that could not be resolved.
+         */
+        QHash<QString, QDomNode> qhashPathNodes;
+
+        /**
+         * id attribute -> node maps for indexed lookups, key is the path key.
+         */
+        QHash<QString, QHash<unsigned int, QDomNode> > qhashPathIndex;
+
+        /**
+         * \brief Resolves the path prefix up to a given depth.
+         *
+         * Uses the deepest memorised prefix as start node and memorises all newly
+         * resolved prefixes.
+         *
+         * @param[in] const XMLPath& clXmlPath = compiled path
+         * @param[in] const int iDepth = number of path elements to be resolved
+         * \return QDomNode = resolved node / NULL node if the prefix cannot be resolved
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QDomNode resolvePathPrefix (const XMLPath& clXmlPath, const int iDepth);
+
     public:
         /**
          * \brief This the class contructor.
@@ -86,6 +206,53 @@ class XMLParser
 
         ~XMLParser();
 
+        /**
+         * \brief Walks all elements below the root node in document order (pre-order).
+         *
+         * The visitor is called for each element and stops the walk by returning
+         * true. No node list is built, hence the walk can stop at the first match.
+         *
+         * @param[in] const QDomNode& clRootNode = root node of the walk
+         * @param[in] Visitor fnVisit = callable bool (const QDomNode& clNode)
+         * \return QDomNode = element, that stopped the walk / NULL node if the walk was completed
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        template <typename Visitor>
+        static QDomNode walkSubNodes (const QDomNode& clRootNode, Visitor fnVisit)
+        {
+            // declaration of variables
+            QDomNode clNode = clRootNode.firstChild();
+
+            while (clNode.isNull() == false)
+            {
+                if ((clNode.isElement() == true) && (fnVisit (clNode) == true))
+                {
+                    return (clNode);
+                }
+
+                if (clNode.hasChildNodes() == true)
+                {
+                    clNode = clNode.firstChild();
+                }
+                else
+                {
+                    while (clNode.nextSibling().isNull() == true)
+                    {
+                        clNode = clNode.parentNode();
+                        if ((clNode.isNull() == true) || (clNode == clRootNode))
+                        {
+                            return (QDomNode ());
+                        }
+                    }
+                    clNode = clNode.nextSibling();
+                }
+            }
+
+            return (clNode);
+        }
+
         /**
          * \brief This function is used to read a XML file from string.
          *
@@ -100,6 +267,18 @@ class XMLParser
          */
         bool readXmlFromString (const QString qstrXmlFile);
 
+        /**
+         * \brief Returns the document node of the parsed XML file.
+         *
+         * Can be used as root node for decoders, that walk the complete document.
+         *
+         * \return QDomNode = document node
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        QDomNode getDocumentNode (void) const;
+
         /**
          * \brief This function is used to search for a specific XML node.
          *
@@ -124,6 +303,36 @@ class XMLParser
          */
         bool findXmlNode (QVector<QString> qvecXmlPath, const unsigned int uiIndex, QDomNode &clTargetNode);
 
+        /**
+         * \brief This function is used to search for a specific XML node using a compiled path.
+         *
+         * Same as the function above, but the path is compiled only once. The resolved
+         * nodes are memorised for the current document. For indexed lookups an
+         * id -> node map of the last path element is built on first use, hence
+         * repeated lookups are O(depth) and do not scan the document.
+         *
+         * @param[in] const XMLPath& clXmlPath = compiled path inside the XML file
+         * @param[in] const unsigned int uiIndex = Index (to be used in channel lists), 0xFFFFFFFF if not applied
+         * @param[out] QDomNode& clTargetNode = pointer to be set to point to target node
+         * \return bool = true: target node was found / false: no such node could be found
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        bool findXmlNode (const XMLPath& clXmlPath, const unsigned int uiIndex, QDomNode &clTargetNode);
+
+        /**
+         * \brief Clears the memorised nodes of findXmlNode().
+         *
+         * Is called automatically, if a new document is read or a XML file is inserted.
+         * Needs to be called, if the document structure is modified by other means,
+         * e.g. using nodes returned by findNodes().
+         *
+         * \author MWI
+         * \date 2026-10-19
+         */
+        void clearPathCache (void);
+
         /**
          * \brief This function is used to read the node value of a specific subnode.
          *
@@ -145,6 +354,8 @@ class XMLParser
          * \brief This function is used to read the node value of a specific subnode as unsigned int.
          *
          * Wrapper to read unsigned int values.
+         * The numeric wrappers convert a view of the node text with NumberParser, the
+         * text is shared with the DOM node, hence no string is copied or allocated.
          *
          * @param[in] const QString qstrSubNodeName = name of the subnode to be read
          * @param[in] QDomNode& clRootNode = root node, the search shall be started on